@@ -13,6 +13,13 @@ Import("env")
 # get platformio environment variables
 project_config = util.load_project_config()
 
+# generate sorted OUI table include/vendor_array.h from src/vendors.txt
+sys.path.append(env.subst("$PROJECT_DIR"))
+import vendors
+print "Generating vendor filter table, %d OUIs" % vendors.generate(
+    str(env.get("PROJECTSRC_DIR")) + "/vendors.txt",
+    env.subst("$PROJECT_DIR") + "/include/vendor_array.h")
+
 # check if file loraconf.h is present in source directory
 keyfile = str(env.get("PROJECTSRC_DIR")) + "/loraconf.h"
 if os.path.isfile(keyfile) and os.access(keyfile, os.R_OK):
@@ -1,9 +1,8 @@
 #ifndef _BEACON_ARRAY_H
 #define _BEACON_ARRAY_H
 
-std::array<uint64_t, 0xff>::iterator it;
+// test beacons, preset as ID#0, #1, ... at startup, see remote command 0x12
+static const uint64_t beacon_defaults[] = {
+    0x0000010203040506, 0x0000aabbccddeeff, 0x0000112233445566};
 
-std::array<uint64_t, 0xff> beacons = {0x0000010203040506, 0x0000aabbccddeeff,
-                                      0x0000112233445566};
-
-#endif
\ No newline at end of file
+#endif
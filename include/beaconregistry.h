@@ -0,0 +1,55 @@
+#ifndef _BEACONREGISTRY_H
+#define _BEACONREGISTRY_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Registry of known beacons for monitor mode. Open addressing hash table
+// with linear probing, keyed by 48bit MAC, so lookup is O(1). Each beacon
+// keeps a smoothed RSSI and last seen time. Sightings raise at most one
+// alarm per beacon and holdoff period; pending alarms are collected in one
+// go by the sender. The class holds no iterator or other lookup state, but
+// it is not locked; callers in different tasks must serialize access.
+
+#define BEACON_ID_MAX 254     // beacon ids 0 .. BEACON_ID_MAX
+#define BEACON_RSSI_SHIFT 2   // RSSI smoothing factor 1/2^BEACON_RSSI_SHIFT
+#define BEACON_PENDING 0x01   // alarm raised, not yet collected
+#define BEACON_ALARMED 0x02   // alarm raised at least once
+#define BEACON_SEEN 0x04      // seen at least once, RSSI is valid
+
+#define BEACON_UNKNOWN 0 // return values of seen()
+#define BEACON_KNOWN 1
+#define BEACON_ALARM 2
+
+typedef struct {
+  uint64_t mac;       // 48bit MAC, 0 = slot empty
+  uint32_t lastseen;  // [seconds]
+  uint32_t lastalarm; // [seconds]
+  int16_t rssi;       // smoothed RSSI, fixed point 1/16 dBm
+  uint8_t id;         // beacon id as set by remote command
+  uint8_t flags;
+} Beacon_t;
+
+class BeaconRegistry {
+
+public:
+  BeaconRegistry(uint16_t slots, uint32_t holdoff);
+  ~BeaconRegistry();
+
+  bool set(uint8_t id, uint64_t mac);
+  uint8_t seen(uint64_t mac, int8_t rssi, uint32_t now, uint8_t *id);
+  uint8_t collectAlarms(int8_t rssi[], uint8_t ids[], uint8_t max);
+  uint8_t getCount(void) const;
+  void clear(void);
+
+private:
+  Beacon_t *slots;
+  uint16_t size;
+  uint8_t count;
+  const uint32_t holdoff;
+  uint16_t slot(uint64_t mac) const;
+  int16_t find(uint64_t mac) const;
+  void remove(uint16_t idx);
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef _BLEADV_H
+#define _BLEADV_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Parser of BLE advertising data. Advertising data and scan response are a
+// sequence of AD structures: length byte, AD type byte, length-1 data bytes.
+// The iterator walks them in place, without copying or allocating, and stops
+// at the first zero length (padding) or truncated structure. The parser keeps
+// the fields needed to classify the advertiser; lists and manufacturer data
+// are returned as pointers into the caller's buffer, so they are valid only
+// as long as this buffer.
+
+// AD types evaluated by parser
+#define BLE_AD_FLAGS 0x01
+#define BLE_AD_UUID16_INCOMPLETE 0x02
+#define BLE_AD_UUID16_COMPLETE 0x03
+#define BLE_AD_TXPOWER 0x0A
+#define BLE_AD_SVCDATA16 0x16
+#define BLE_AD_APPEARANCE 0x19
+#define BLE_AD_MANUFACTURER 0xFF
+
+// bits of BleAdv_t.fields, which fields were found
+#define BLE_HAS_FLAGS 0x01
+#define BLE_HAS_UUID16 0x02
+#define BLE_HAS_TXPOWER 0x04
+#define BLE_HAS_SVCDATA 0x08
+#define BLE_HAS_APPEARANCE 0x10
+#define BLE_HAS_MANUFACTURER 0x20
+
+// advertiser classes
+#define BLE_CLASS_PHONE 0    // phones, tablets, computers
+#define BLE_CLASS_WEARABLE 1 // watches, fitness trackers, headphones
+#define BLE_CLASS_BEACON 2   // beacons and tags
+#define BLE_CLASS_OTHER 3    // anything else, or not identifiable
+#define BLE_CLASSES 4
+#define BLE_CLASS_ALL ((1 << BLE_CLASSES) - 1) // bit set of all classes
+
+// fields of advertisement a classification rule compares
+#define BLE_RULE_APPEARANCE 0   // appearance value
+#define BLE_RULE_MANUFACTURER 1 // company id << 8 | first byte of data
+#define BLE_RULE_UUID16 2       // any listed 16bit service or service data UUID
+
+typedef struct {
+  uint8_t field; // BLE_RULE_xxx
+  uint8_t cls;   // BLE_CLASS_xxx of matching advertisers
+  uint32_t key;  // rule matches if (field value & mask) == key
+  uint32_t mask;
+} BleRule_t;
+
+typedef struct {
+  const uint8_t *pos, *end;
+} BleAdIter_t;
+
+typedef struct {
+  const uint8_t *uuid16; // 16bit service UUIDs, little endian, in place
+  const uint8_t *mfdata; // manufacturer data after company id, in place
+  uint16_t company;      // manufacturer company id
+  uint16_t appearance;
+  uint16_t svcdata;      // UUID of first 16bit service data
+  int8_t txpower;        // [dBm]
+  uint8_t flags;
+  uint8_t uuid16_len;    // [bytes]
+  uint8_t mfdata_len;    // [bytes]
+  uint8_t fields;        // BLE_HAS_xxx bits
+} BleAdv_t;
+
+void ble_ad_begin(BleAdIter_t *it, const uint8_t *data, uint8_t len);
+bool ble_ad_next(BleAdIter_t *it, uint8_t *type, const uint8_t **data,
+                 uint8_t *len);
+void ble_adv_parse(const uint8_t *data, uint8_t len, BleAdv_t *adv);
+uint8_t ble_adv_classify(const BleAdv_t *adv, const BleRule_t rules[],
+                         uint8_t n);
+uint8_t ble_classify(const uint8_t *data, uint8_t len);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _BLECLASS_ARRAY_H
+#define _BLECLASS_ARRAY_H
+
+#include "bleadv.h"
+
+// rules to classify BLE advertisers, see remote command 0x15; first matching
+// rule wins, advertisers matching no rule are BLE_CLASS_OTHER
+static const BleRule_t bleclass_rules[] = {
+    // Apple, by type of first continuity message
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_BEACON, 0x004C02, 0xFFFFFF}, // iBeacon
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_WEARABLE, 0x004C07, 0xFFFFFF}, // AirPods
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_PHONE, 0x004C0F, 0xFFFFFF}, // nearby action
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_PHONE, 0x004C10, 0xFFFFFF}, // nearby info
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_BEACON, 0x004C12, 0xFFFFFF}, // Find My, AirTag
+    // Microsoft connected devices platform, Windows computers and phones
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_PHONE, 0x000601, 0xFFFFFF},
+    // wearable vendors: Garmin, Huami, Fitbit
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_WEARABLE, 0x008700, 0xFFFF00},
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_WEARABLE, 0x015700, 0xFFFF00},
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_WEARABLE, 0x012400, 0xFFFF00},
+    // beacon vendors: Ruuvi, Estimote
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_BEACON, 0x049900, 0xFFFF00},
+    {BLE_RULE_MANUFACTURER, BLE_CLASS_BEACON, 0x015D00, 0xFFFF00},
+    // services
+    {BLE_RULE_UUID16, BLE_CLASS_PHONE, 0xFD6F, 0xFFFF}, // exposure notification
+    {BLE_RULE_UUID16, BLE_CLASS_PHONE, 0xFE9F, 0xFFFF}, // Google
+    {BLE_RULE_UUID16, BLE_CLASS_WEARABLE, 0xFE2C, 0xFFFF}, // Google fast pair
+    {BLE_RULE_UUID16, BLE_CLASS_WEARABLE, 0x180D, 0xFFFF}, // heart rate
+    {BLE_RULE_UUID16, BLE_CLASS_BEACON, 0xFEAA, 0xFFFF},   // Eddystone
+    {BLE_RULE_UUID16, BLE_CLASS_BEACON, 0xFEED, 0xFFFF},   // Tile
+    {BLE_RULE_UUID16, BLE_CLASS_BEACON, 0xFD5A, 0xFFFF},   // Samsung SmartTag
+    // appearance, by category in bits 6..15
+    {BLE_RULE_APPEARANCE, BLE_CLASS_PHONE, 0x0040, 0xFFC0},    // phone
+    {BLE_RULE_APPEARANCE, BLE_CLASS_PHONE, 0x0080, 0xFFC0},    // computer
+    {BLE_RULE_APPEARANCE, BLE_CLASS_WEARABLE, 0x00C0, 0xFFC0}, // watch
+    {BLE_RULE_APPEARANCE, BLE_CLASS_WEARABLE, 0x01C0, 0xFFC0}, // eye glasses
+    {BLE_RULE_APPEARANCE, BLE_CLASS_BEACON, 0x0200, 0xFFC0},   // tag
+    {BLE_RULE_APPEARANCE, BLE_CLASS_BEACON, 0x0240, 0xFFC0},   // keyring
+    {BLE_RULE_APPEARANCE, BLE_CLASS_WEARABLE, 0x0340, 0xFFC0}, // heart rate
+    {BLE_RULE_APPEARANCE, BLE_CLASS_WEARABLE, 0x0440, 0xFFC0}, // running
+    {BLE_RULE_APPEARANCE, BLE_CLASS_WEARABLE, 0x0840, 0xFFC0}, // audio sink
+    {BLE_RULE_APPEARANCE, BLE_CLASS_WEARABLE, 0x0940, 0xFFC0}, // earbuds
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "globals.h"
 #include "macsniff.h"
+#include "bleadv.h"
 
 // Bluetooth specific includes
 #include <esp_bt.h>
@@ -13,5 +14,8 @@
 
 void start_BLEscan(void);
 void stop_BLEscan(void);
+void gap_callback_handler(esp_gap_ble_cb_event_t event,
+                          esp_ble_gap_cb_param_t *param);
+uint32_t ble_adverts(uint8_t cls);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef _BUFFERPOOL_H
+#define _BUFFERPOOL_H
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <atomic>
+
+// Lock-free pool of N reference counted buffers, shared by any number of
+// producer and consumer contexts. alloc() hands out a free buffer holding
+// one reference, each further owner takes one by retain() and drops it by
+// release(); the last release() returns the buffer to the pool. Queues
+// then carry pointers instead of copies. Requests while all buffers are in
+// use fail and are counted, the caller never blocks.
+
+template <class T, uint8_t N> class BufferPool {
+
+public:
+  BufferPool() : exhausted(0), highwater(0) {
+    for (uint8_t i = 0; i < N; i++)
+      refs[i].store(0, std::memory_order_relaxed);
+  }
+
+  // returns a free buffer with one reference, or NULL if all are in use.
+  // First fit, so buffer i is taken only while buffers 0..i-1 are in use,
+  // and the highest one ever taken tells the peak number in use
+  T *alloc(void) {
+    for (uint8_t i = 0; i < N; i++) {
+      uint8_t expected = 0;
+      if (refs[i].compare_exchange_strong(expected, 1,
+                                          std::memory_order_acquire)) {
+        if (i >= highwater)
+          highwater = i + 1;
+        return &items[i];
+      }
+    }
+    exhausted++;
+    return NULL;
+  }
+
+  void retain(T *item) {
+    refs[item - items].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void release(T *item) {
+    refs[item - items].fetch_sub(1, std::memory_order_release);
+  }
+
+  uint8_t capacity(void) const { return N; }
+  // buffers in use, a snapshot while other contexts alloc or release
+  uint8_t getUsed(void) const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < N; i++)
+      n += refs[i].load(std::memory_order_relaxed) != 0;
+    return n;
+  }
+  uint32_t getExhausted(void) const { return exhausted; }
+  uint8_t getHighwater(void) const { return highwater; }
+
+private:
+  T items[N];
+  std::atomic<uint8_t> refs[N];
+  volatile uint32_t exhausted; // racy increments only lose counts
+  volatile uint8_t highwater;
+};
+
+#endif
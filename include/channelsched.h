@@ -0,0 +1,50 @@
+#ifndef _CHANNELSCHED_H
+#define _CHANNELSCHED_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Traffic adaptive Wifi channel hopping. Time is split into slots of one
+// channel switch interval. Each channel keeps a smoothed yield of new unique
+// devices per slot, and slots are handed out by smooth weighted round robin
+// with weight yield + CHANNEL_WEIGHT_MIN, so productive channels are listened
+// to more often while quiet channels still get a minimum share. A channel
+// not listened to for revisit slots is taken next in any case. revisit 0
+// falls back to plain round robin. The class is not locked; callers in
+// different tasks must serialize access.
+
+#define CHANNEL_MAX 14          // highest 2.4 GHz channel number
+#define CHANNEL_YIELD_ONE 256   // fixed point 1.0 of yield
+#define CHANNEL_YIELD_SHIFT 3   // yield smoothing factor 1/2^CHANNEL_YIELD_SHIFT
+#define CHANNEL_WEIGHT_MIN 16   // weight of channel without yield, 1/16 device
+
+typedef struct {
+  int32_t yield;      // smoothed new devices per slot, fixed point
+  int32_t credit;     // weighted round robin account
+  uint32_t lastvisit; // slot number when channel was last listened to
+  uint16_t hits;      // new devices since channel was last listened to
+  uint16_t slots;     // slots listened to since last statistics reset
+} ChannelStat_t;
+
+class ChannelScheduler {
+
+public:
+  ChannelScheduler(uint8_t first, uint8_t last, uint16_t revisit);
+
+  void hit(uint8_t channel);
+  uint8_t next(void);
+  uint8_t getChannel(void) const;
+  uint32_t getYield(uint8_t channel) const;
+  uint16_t getSlots(uint8_t channel) const;
+  void resetStats(void);
+  void setRevisit(uint16_t revisit);
+
+private:
+  ChannelStat_t stat[CHANNEL_MAX + 1]; // indexed by channel number
+  const uint8_t first, last;
+  uint8_t current;
+  uint16_t revisit;
+  uint32_t tick;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef _COUNTSERIES_H
+#define _COUNTSERIES_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Time series of counts, one sample per send cycle, kept while counts can
+// not be sent. A run of samples is encoded as sequence number of its first
+// sample, content bits and number of samples, then the first sample as base
+// and each following one as zigzag delta to its predecessor, all counts as
+// LEB128 varints, so counts changing by less than 64 per cycle take one byte
+// each. Counts changing more are written raw, 16 bit each, if that is
+// shorter. Flags of estimated counts follow each sample as one byte, if any
+// sample of the run has flags. The ring overwrites its oldest samples when
+// full; sequence numbers show the gap. decode() is the counterpart for
+// receivers and host tools.
+
+#define COUNTSERIES_HEADER 3    // bytes of sequence number, content and run
+#define COUNTSERIES_BLE 0x01    // content: samples have BLE counts
+#define COUNTSERIES_BOTH 0x02   // content: samples have counts seen on both
+#define COUNTSERIES_FLAGS 0x04  // content: samples have flags byte
+#define COUNTSERIES_RAW 0x08    // content: counts are raw, 16 bit LSB first
+#define COUNTSERIES_RUN 127     // max. samples per run
+#define COUNTSERIES_SAMPLE_MAX 10 // bytes of a sample, worst case
+
+typedef struct {
+  uint16_t wifi;
+  uint16_t ble;
+  uint16_t both; // devices seen on Wifi and BLE, see CROSS_DEDUP
+  uint8_t flags; // which counts are estimated, see payload.h
+} CountSample_t;
+
+class CountSeries {
+
+public:
+  CountSeries(uint16_t size);
+  ~CountSeries();
+
+  void add(const CountSample_t *sample);
+  uint8_t encode(uint8_t *buf, uint8_t len, uint8_t content,
+                 uint8_t *taken) const;
+  void drop(uint16_t n);
+  uint16_t getCount(void) const;
+  uint32_t getLost(void) const;
+  void clear(void);
+
+  static uint8_t decode(const uint8_t *buf, uint8_t len, uint8_t *seq,
+                        CountSample_t samples[], uint8_t max);
+
+private:
+  uint8_t putRun(uint8_t *buf, uint8_t len, uint8_t content, uint16_t max,
+                 size_t *n) const;
+
+  CountSample_t *samples;
+  const uint16_t size;
+  uint16_t head;  // index of oldest sample
+  uint16_t count; // samples kept
+  uint8_t seq;    // sequence number of oldest sample
+  uint32_t lost;  // samples overwritten before they were sent
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef _COUNTWINDOW_H
+#define _COUNTWINDOW_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Sliding window dedup store for 16bit MAC hashes. Keeps a one byte
+// last-seen minute stamp per possible hash value (64 KB arena, provided by
+// caller) and answers "unique hashes seen in the last W minutes" for several
+// windows in one pass. Stamps run modulo COUNTWINDOW_TICKS, so count() must
+// be called at least every (COUNTWINDOW_TICKS - largest window) minutes to
+// expire old stamps before they wrap.
+
+#define COUNTWINDOW_SIZE 65536
+#define COUNTWINDOW_TICKS 255
+#define COUNTWINDOW_EMPTY 0xFF
+#define COUNTWINDOW_MAX 240 // [minutes] largest window supported
+
+class CountWindow {
+
+public:
+  CountWindow();
+
+  void begin(uint8_t *arena);
+  bool isActive(void) const;
+  void add(uint16_t hash, uint32_t minute);
+  void count(uint32_t minute, const uint8_t windows[], uint16_t counts[],
+             uint8_t n);
+  void clear(void);
+
+private:
+  uint8_t *stamps;
+};
+
+#endif
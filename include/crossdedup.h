@@ -0,0 +1,64 @@
+#ifndef _CROSSDEDUP_H
+#define _CROSSDEDUP_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Estimates how many devices were counted on both Wifi and BLE in one send
+// cycle. Two kinds of evidence pair a new device with one of the other
+// technology, each device is paired at most once:
+// - address: many chipsets derive the public BLE address from the Wifi MAC,
+//   same OUI and NIC differing by up to CROSS_NIC_SPAN. Salted 32bit keys of
+//   public addresses are kept in an open addressing table, a new address
+//   probes the keys of its neighbours of the other technology, O(1).
+// - co-occurrence: a device of each technology first seen within window
+//   and with RSSI differing by at most rssidiff, not both with public
+//   address. Only taken if there is exactly one such candidate among the
+//   recent arrivals, so crowds, where co-occurrence is meaningless, yield
+//   no pairs.
+// The class is not locked; it is meant for the single MAC counting task.
+
+#define CROSS_WIFI 0
+#define CROSS_BLE 1
+#define CROSS_RECENT 8   // recent unpaired arrivals kept per technology
+#define CROSS_NIC_SPAN 2 // max. distance of NICs of Wifi MAC and BLE address
+
+#define CROSS_PAIRED 0x02 // flag in low bits of key, bit 0 is technology
+#define CROSS_USED 0x01   // flags of arrival
+#define CROSS_TAKEN 0x02
+
+typedef struct {
+  uint32_t time; // [milliseconds]
+  int16_t slot;  // key of device in table, -1 if none
+  int8_t rssi;
+  uint8_t flags;
+} CrossArrival_t;
+
+class CrossDedup {
+
+public:
+  CrossDedup(uint16_t slots, uint32_t window, uint8_t rssidiff);
+  ~CrossDedup();
+
+  bool add(const uint8_t *mac, uint8_t tech, bool linkable, int8_t rssi,
+           uint32_t now, uint32_t salt);
+  uint16_t getBoth(void) const;
+  uint16_t getLinked(void) const;
+  void clear(void);
+
+private:
+  uint32_t *slots;
+  CrossArrival_t recent[2][CROSS_RECENT];
+  uint8_t head[2];
+  uint16_t size, count, both, linked;
+  const uint32_t window;
+  const uint8_t rssidiff;
+  uint32_t key(const uint8_t *mac, int8_t delta, uint8_t tech,
+               uint32_t salt) const;
+  int16_t find(uint32_t key) const;
+  int16_t insert(uint32_t key);
+  void take(uint8_t tech, int16_t slot);
+  bool cooccur(uint8_t tech, int8_t rssi, uint32_t now, int16_t slot);
+};
+
+#endif
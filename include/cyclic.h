@@ -5,6 +5,7 @@
 #include "senddata.h"
 #include "rcommand.h"
 #include "spislave.h"
+#include "macqueue.h"
 #include <lmic.h>
 
 #ifdef HAS_BME
@@ -0,0 +1,52 @@
+#ifndef _DWELLTABLE_H
+#define _DWELLTABLE_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Dwell time tracker for 16bit MAC hashes. A fixed arena, provided by caller,
+// holds first-seen/last-seen timestamps for a bounded number of devices in a
+// hash table with LRU list, so seen() is O(1). Devices not seen for a while,
+// or evicted as least recently seen when the table is full, are finished
+// visits and go into a log2 scaled dwell time histogram:
+// bin 0: < 1 min, bin 1: 1..2 min, bin 2: 2..4 min, ... bin 7: >= 64 min
+
+#define DWELL_BINS 8
+#define DWELL_NIL 0xFFFF
+
+typedef struct {
+  uint16_t hash;  // MAC hash
+  uint16_t next;  // next entry in hash bucket chain or free list
+  uint16_t older; // LRU list neighbours
+  uint16_t newer;
+  uint32_t first; // first seen [seconds]
+  uint32_t last;  // last seen [seconds]
+} DwellEntry_t;
+
+class DwellTable {
+
+public:
+  DwellTable();
+
+  static size_t arenaSize(uint16_t entries);
+  void begin(void *arena, uint16_t entries);
+  bool isActive(void) const;
+  void seen(uint16_t hash, uint32_t now);
+  void expire(uint32_t now, uint32_t timeout);
+  void clear(void);
+  const uint16_t *getHistogram(void) const;
+  void resetHistogram(void);
+  uint16_t getUsed(void) const;
+
+private:
+  DwellEntry_t *entries;
+  uint16_t *buckets;
+  uint16_t size, used, freelist, newest, oldest;
+  uint16_t histogram[DWELL_BINS];
+  void finish(uint16_t idx);
+  void unlinkLRU(uint16_t idx);
+  void unlinkBucket(uint16_t idx);
+  void pushLRU(uint16_t idx);
+};
+
+#endif
@@ -8,16 +8,20 @@
 #include <Time.h>
 #include <Timezone.h>
 
-// std::set for unified array functions
-#include <set>
+// std::array for unified array functions
 #include <array>
 #include <algorithm>
 #include "mallocator.h"
+#include "macbitmap.h"
+#include "hyperloglog.h"
+#include "bufferpool.h"
 #include "../lib/Bosch-BSEC/src/inc/bsec_datatypes.h"
 
 // sniffing types
 #define MAC_SNIFF_WIFI 0
 #define MAC_SNIFF_BLE 1
+#define MAC_SNIFF_PROBE 2 // Wifi, randomized MAC replaced by its cluster's
+#define MAC_SNIFF_BOTH 3  // Wifi and BLE, counts of devices seen on both
 
 // bits in payloadmask for filtering payload data
 #define GPS_DATA (0x01)
@@ -43,6 +47,12 @@
 #define I2C_MUTEX_LOCK()    xSemaphoreTake(I2Caccess, (DISPLAYREFRESH_MS / portTICK_PERIOD_MS)) == pdTRUE
 #define I2C_MUTEX_UNLOCK()  xSemaphoreGive(I2Caccess)
 
+// counting state access control: MAC containers, sketch, window, dwell, band,
+// cross and visit stores, counters and salt are written by macloop task and
+// read, sent and reset by irq handler task and remote commands
+#define COUNT_MUTEX_LOCK()    xSemaphoreTake(CountAccess, portMAX_DELAY)
+#define COUNT_MUTEX_UNLOCK()  xSemaphoreGive(CountAccess)
+
 // Struct holding devices's runtime configuration
 typedef struct {
   uint8_t lorasf;      // 7-12, lora spreadfactor
@@ -50,7 +60,8 @@ typedef struct {
   uint8_t adrmode;     // 0=disabled, 1=enabled
   uint8_t screensaver; // 0=disabled, 1=enabled
   uint8_t screenon;    // 0=disabled, 1=enabled
-  uint8_t countermode; // 0=cyclic unconfirmed, 1=cumulative, 2=cyclic confirmed
+  uint8_t countermode; // 0=cyclic unconfirmed, 1=cumulative, 2=cyclic confirmed,
+                       // 3=cyclic with HyperLogLog sketch
   int16_t rssilimit;   // threshold for rssilimiter, negative value!
   uint8_t sendcycle;   // payload send cycle [seconds/2]
   uint8_t wifichancycle; // wifi channel switch cycle [seconds/100]
@@ -60,6 +71,10 @@ typedef struct {
   uint8_t vendorfilter;  // 0=disabled, 1=enabled
   uint8_t rgblum;        // RGB Led luminosity (0..100%)
   uint8_t monitormode;   // 0=disabled, 1=enabled
+  uint8_t wififilter;    // 0=all frames, 1=client frames, 2=probe requests
+  uint8_t bleclasses;    // bit set of counted BLE advertiser classes
+  int8_t rssiband[2];    // lower edges of near and mid RSSI band [dBm]
+  uint8_t payloadformat; // 1=plain, 2=packed, 3=LPP dynamic, 4=LPP packed
   uint8_t runmode;       // 0=normal, 1=update
   uint8_t payloadmask;   // bitswitches for payload data
   char version[10];      // Firmware version
@@ -70,9 +85,18 @@ typedef struct {
 typedef struct {
   uint8_t MessageSize;
   uint8_t MessagePort;
+  uint8_t MessagePrio; // send class, see sendscheduler.h
+  uint32_t MessageKey; // bits of ports a newer message supersedes, 0 = none
   uint8_t Message[PAYLOAD_BUFFER_SIZE];
 } MessageBuffer_t;
 
+// Statistics of a send queue per send class
+typedef struct {
+  uint32_t queued;    // messages pushed
+  uint32_t coalesced; // messages replaced by a newer one before sending
+  uint32_t dropped;   // messages refused or evicted because queue was full
+} SendStats_t;
+
 typedef struct {
   int32_t latitude;
   int32_t longitude;
@@ -92,6 +116,17 @@ typedef struct {
   float gas;             // raw gas sensor signal
 } bmeStatus_t;
 
+typedef struct {
+  uint16_t wififrames;    // Wifi frames received [per second]
+  uint16_t bleadverts;    // BLE advertisements received [per second]
+  uint16_t rssidropped;   // frames and adverts below RSSI limit [per second]
+  uint16_t vendordropped; // MACs dropped by vendor filter [per second]
+  uint16_t ringdropped;   // records lost due to full rings [per second]
+  uint16_t collisions;    // hash collisions in this send cycle, estimated
+  uint16_t insertns;      // mean time to count one record [nanoseconds]
+  uint16_t batchmaxus;    // max. time to count one batch [microseconds]
+} perfStatus_t;
+
 // global variables
 extern configData_t cfg;                      // current device configuration
 extern char display_line6[], display_line7[]; // screen buffers
@@ -99,11 +134,11 @@ extern uint8_t volatile channel;              // wifi channel rotation counter
 extern uint16_t volatile macs_total, macs_wifi, macs_ble,
     batt_voltage; // display values
 extern hw_timer_t *channelSwitch, *sendCycle, *displaytimer;
-extern SemaphoreHandle_t I2Caccess;
+extern SemaphoreHandle_t I2Caccess, CountAccess;
 
-extern std::set<uint16_t, std::less<uint16_t>, Mallocator<uint16_t>> macs;
-extern std::array<uint64_t, 0xff>::iterator it;
-extern std::array<uint64_t, 0xff> beacons;
+extern MacBitmap macs, blemacs;
+extern HyperLogLog sketch;
+extern BufferPool<MessageBuffer_t, SEND_POOL_SIZE> sendpool;
 
 extern TaskHandle_t irqHandlerTask, wifiSwitchTask;
 extern Timezone myTZ; // make Timezone myTZ globally available
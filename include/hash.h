@@ -5,5 +5,9 @@
 #include <inttypes.h>
 
 uint32_t IRAM_ATTR rokkit(const char *data, int len);
+uint32_t IRAM_ATTR mac_hash32(const uint8_t *paddr, uint32_t salt);
+uint16_t IRAM_ATTR mac_hash(const uint8_t *paddr, uint32_t salt);
+void IRAM_ATTR mac_hash_batch(const uint8_t *paddr, size_t stride,
+                              uint16_t *hashes, uint16_t n, uint32_t salt);
 
 #endif
\ No newline at end of file
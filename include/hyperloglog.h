@@ -0,0 +1,38 @@
+#ifndef _HYPERLOGLOG_H
+#define _HYPERLOGLOG_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// HyperLogLog cardinality sketch over 32bit hashes, see
+// http://algo.inria.fr/flajolet/Publications/FlFuGaMe07.pdf
+// Sketches with same precision and hash key can be merged register by
+// register (max), so counts of several devices and/or several time windows
+// can be combined without double counting. This code does not depend on
+// Arduino or ESP-IDF and can be used for backend side merging, too.
+
+#define HLL_PRECISION_MIN 4
+#define HLL_PRECISION_MAX 8 // payload addresses registers by 1 byte offset
+
+class HyperLogLog {
+
+public:
+  HyperLogLog(uint8_t precision);
+  ~HyperLogLog();
+
+  bool add(uint32_t hash);
+  void merge(const HyperLogLog &other);
+  bool merge(const uint8_t *regs, uint16_t offset, uint16_t count);
+  uint32_t estimate(void) const;
+  void clear(void);
+  uint8_t getPrecision(void) const;
+  uint16_t getSize(void) const;
+  const uint8_t *getRegisters(void) const;
+
+private:
+  uint8_t precision;
+  uint16_t size;
+  uint8_t *registers;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #define BUTTON_IRQ 0x02
 #define SENDCOUNTER_IRQ 0x04
 #define CYCLIC_IRQ 0x08
+#define BEACON_IRQ 0x10
 
 #include "globals.h"
 #include "cyclic.h"
@@ -21,8 +21,6 @@
 #include "rtctime.h"
 #endif
 
-extern QueueHandle_t LoraSendQueue;
-
 void onEvent(ev_t ev);
 void gen_lora_deveui(uint8_t *pdeveui);
 void RevBytes(unsigned char *b, size_t c);
@@ -35,6 +33,10 @@ void switch_lora(uint8_t sf, uint8_t tx);
 void lora_send(osjob_t *job);
 void lora_enqueuedata(MessageBuffer_t *message);
 void lora_queuereset(void);
+uint8_t lora_queuewaiting(void);
+const SendStats_t *lora_sendstats(uint8_t cls);
+uint8_t lora_maxpayload(void);
+bool lora_busy(void);
 void lora_housekeeping(void);
 void user_request_network_time_callback(void *pVoidUserUTCTime,
                                         int flagSuccess);
@@ -0,0 +1,41 @@
+#ifndef _MACBITMAP_H
+#define _MACBITMAP_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include <utility> // std::pair
+
+// fixed size dedup store for 16bit MAC hashes, one bit per possible hash
+// value, so memory footprint is 8 KB regardless of number of devices seen.
+// insert() mimics std::set<uint16_t>::insert(), .second is true if new.
+// With many devices, hashes collide and the number of set bits falls short
+// of the number of devices; estimate() then corrects it by linear counting.
+// save() serializes the set compactly for snapshots, see snapshot.h.
+
+#define MACBITMAP_BITS 65536
+#define MACBITMAP_WORDS (MACBITMAP_BITS / 32)
+#define MACBITMAP_EXACT (MACBITMAP_BITS / 64) // set bits, shortfall below 1%
+#define MACBITMAP_SPARSE 0 // serialized as count and varint gaps of hashes
+#define MACBITMAP_RAW 1    // serialized as all words of the bitmap
+#define MACBITMAP_SAVED_MAX (1 + MACBITMAP_WORDS * 4) // max. serialized size
+
+class MacBitmap {
+
+public:
+  MacBitmap();
+
+  std::pair<uint16_t, bool> insert(uint16_t value);
+  size_t erase(uint16_t value);
+  void merge(const MacBitmap &other);
+  bool contains(uint16_t value) const;
+  size_t size(void) const;
+  uint16_t estimate(bool *estimated) const;
+  size_t save(uint8_t *buf, size_t len) const;
+  size_t load(const uint8_t *buf, size_t len);
+  void clear(void);
+
+private:
+  uint32_t bits[MACBITMAP_WORDS];
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef _MACQUEUE_H
+#define _MACQUEUE_H
+
+#include "globals.h"
+#include "ringbuffer.h"
+#include "macsniff.h"
+#include "probecluster.h"
+#include "perfstats.h"
+
+// record of a sniffed device, pushed by the sniffer callbacks
+typedef struct {
+  uint8_t mac[6];     // sender address
+  int8_t rssi;        // reception level
+  uint8_t channel;    // wifi channel, for BLE esp_ble_addr_type_t
+  uint32_t timestamp; // millis() when frame was seen
+#ifdef PROBE_FINGERPRINT
+  uint32_t fingerprint; // of probe request with randomized MAC, else 0
+  uint16_t seq;         // 802.11 sequence number of probe request
+#endif
+} MacRecord_t;
+
+extern TaskHandle_t macLoopTask;
+
+void mac_queue_init(void);
+void mac_loop(void *pvParameters);
+uint16_t mac_queue_process(void);
+bool mac_queue_idle(void);
+bool IRAM_ATTR mac_enqueue(const uint8_t *paddr, int8_t rssi, uint8_t channel,
+                           uint8_t sniff_type, uint32_t fingerprint = 0,
+                           uint16_t seq = 0);
+uint32_t mac_queue_dropped(uint8_t sniff_type);
+uint16_t mac_queue_highwater(uint8_t sniff_type);
+#ifdef PROBE_FINGERPRINT
+uint32_t mac_queue_probes(void);
+uint32_t mac_queue_merged(void);
+#endif
+
+#endif
@@ -6,15 +6,71 @@
 
 // Hash function for scrambling MAC addresses
 #include "hash.h"
+#include "countwindow.h"
+#include "dwelltable.h"
+#include "beaconregistry.h"
+#include "rssibands.h"
+#include "crossdedup.h"
+#include <esp_timer.h>
 #include "senddata.h"
 #include "cyclic.h"
 
 #define MAC_SNIFF_WIFI 0
 #define MAC_SNIFF_BLE 1
+#define MAC_SNIFF_PROBE 2 // Wifi, randomized MAC replaced by its cluster's
+#define MAC_SNIFF_BOTH 3  // Wifi and BLE, counts of devices seen on both
 
-uint16_t get_salt(void);
+extern uint32_t salt, epoch;
+
+uint32_t get_salt(void);
+uint32_t uptime_seconds(void);
+void beacon_init(void);
+bool beacon_set(uint8_t id, uint64_t mac);
+uint8_t beacon_alarms(int8_t rssi[], uint8_t ids[], uint8_t max);
 uint64_t macConvert(uint8_t *paddr);
-bool mac_add(uint8_t *paddr, int8_t rssi, bool sniff_type);
+#ifdef VENDORFILTER
+bool isVendor(uint32_t oui);
+#endif
+bool mac_add(uint8_t *paddr, uint16_t hashedmac, int8_t rssi,
+             uint8_t sniff_type);
+uint16_t mac_both(void);
 void printKey(const char *name, const uint8_t *key, uint8_t len, bool lsb);
 
-#endif
\ No newline at end of file
+#if defined(COUNT_WINDOWS) || defined(DWELL_ENTRIES)
+uint32_t window_minute(void);
+uint16_t long_hash(const uint8_t *paddr);
+void longsalt_check(void);
+#endif
+
+#ifdef COUNT_WINDOWS
+extern CountWindow countwindow;
+void window_init(void);
+#endif
+
+#ifdef DWELL_ENTRIES
+extern DwellTable dwelltable;
+void dwell_init(void);
+#endif
+
+#ifdef CROSS_DEDUP
+extern CrossDedup crossdedup;
+void cross_add(const uint8_t *paddr, uint8_t sniff_type, uint8_t addrtype,
+               int8_t rssi, uint32_t now);
+#endif
+
+#ifdef COUNT_BANDS
+extern RssiBands rssibands;
+void bands_init(void);
+#endif
+
+#ifdef COUNT_VISITS
+void visits_get(uint16_t *newpax, uint16_t *back, uint16_t *departed);
+void visits_rotate(void);
+#endif
+
+#ifdef SNAPSHOT_SIZE
+void snapshot_save(bool flash);
+bool snapshot_restore(void);
+#endif
+
+#endif
@@ -9,9 +9,9 @@
 #include "globals.h"
 #include "blescan.h"
 #include "wifiscan.h"
+#include "macqueue.h"
 #include "configmanager.h"
 #include "cyclic.h"
-#include "beacon_array.h"
 #include "ota.h"
 #include "irqhandler.h"
 #include "led.h"
@@ -1,9 +1,13 @@
 #ifndef _PAYLOAD_H_
 #define _PAYLOAD_H_
 
-// MyDevices CayenneLPP channels for dynamic sensor payload format
-#if (PAYLOAD_ENCODER == 3)
+// payload formats, default is PAYLOAD_ENCODER, remote command 0x17 selects
+#define PAYLOAD_PLAIN 1       // plain, big endian, own port per record type
+#define PAYLOAD_PACKED 2      // LoRa serialization, own port per record type
+#define PAYLOAD_LPP_DYNAMIC 3 // Cayenne LPP with channels, all on LPP1PORT
+#define PAYLOAD_LPP_PACKED 4  // Cayenne LPP without channels, all on LPP2PORT
 
+// MyDevices CayenneLPP channels for dynamic sensor payload format
 #define LPP_GPS_CHANNEL 20
 #define LPP_COUNT_WIFI_CHANNEL 21
 #define LPP_COUNT_BLE_CHANNEL 22
@@ -16,8 +20,16 @@
 #define LPP_HUMIDITY_CHANNEL 29
 #define LPP_BAROMETER_CHANNEL 30
 #define LPP_AIR_CHANNEL 31 
+#define LPP_WINDOW_CHANNEL 32 // first of up to 8 channels for window counts
+#define LPP_DWELL_CHANNEL 40  // first of 8 channels for dwell time histogram
+#define LPP_BAND_CHANNEL 48   // first of 3 channels for RSSI band counts
+#define LPP_COUNT_BOTH_CHANNEL 51
+#define LPP_COUNT_FLAGS_CHANNEL 52
+#define LPP_VISIT_CHANNEL 53 // first of 3 channels for new, returning, departed
 
-#endif
+// flags of counter payload, which counts are estimates
+#define COUNT_ESTIMATED_WIFI 0x01
+#define COUNT_ESTIMATED_BLE 0x02
 
 // MyDevices CayenneLPP types
 #define LPP_GPS 136          // 3 byte lon/lat 0.0001 °, 3 bytes alt 0.01m
@@ -30,6 +42,11 @@
 #define LPP_HUMIDITY 104     // 1 byte, 0.5 % unsigned
 #define LPP_BAROMETER 115    // 2 bytes, hPa unsigned MSB
 
+// Encodes records in one of the payload formats, selectable at runtime. All
+// formats are compiled in as policy classes (see payload.cpp), each add*()
+// dispatches once to the selected one, which is then inlined. The size of
+// each record is known per format at compile time, a record which does not
+// fit into the buffer is refused as a whole and add*() returns false.
 class PayloadConvert {
 
 public:
@@ -39,51 +56,50 @@ public:
   void reset(void);
   uint8_t getSize(void);
   uint8_t *getBuffer(void);
-  void addCount(uint16_t value, uint8_t sniffytpe);
-  void addConfig(configData_t value);
-  void addStatus(uint16_t voltage, uint64_t uptime, float cputemp, uint32_t mem,
+  bool setFormat(uint8_t format);
+  uint8_t getFormat(void) const;
+  const char *getFormatName(void) const;
+  bool hasPorts(void) const;
+  bool addCount(uint16_t value, uint8_t sniffytpe);
+  bool addCountFlags(uint8_t flags);
+  bool addConfig(configData_t value);
+  bool addStatus(uint16_t voltage, uint64_t uptime, float cputemp, uint32_t mem,
                  uint8_t reset1, uint8_t reset2);
-  void addAlarm(int8_t rssi, uint8_t message);
-  void addVoltage(uint16_t value);
-  void addGPS(gpsStatus_t value);
-  void addBME(bmeStatus_t value);
-  void addButton(uint8_t value);
-  void addSensor(uint8_t[]);
-
-#if PAYLOAD_ENCODER == 1 // format plain
+  bool addAlarm(int8_t rssi, uint8_t message);
+  bool addVoltage(uint16_t value);
+  bool addGPS(gpsStatus_t value);
+  bool addBME(bmeStatus_t value);
+  bool addButton(uint8_t value);
+  bool addSensor(uint8_t[]);
+  bool addSketch(uint8_t precision, uint8_t offset, const uint8_t regs[],
+                 uint8_t count);
+  bool addWindows(const uint8_t windows[], const uint16_t counts[], uint8_t n);
+  bool addDwell(const uint16_t bins[], uint8_t n);
+  bool addChannels(const uint16_t yield[], const uint8_t share[], uint8_t n);
+  bool addBands(const uint16_t counts[], uint8_t n);
+  bool addVisits(uint16_t newpax, uint16_t returning, uint16_t departed);
+  bool addPerf(perfStatus_t value);
+  bool addCountSeries(const uint8_t buf[], uint8_t n);
 
 private:
-  uint8_t *buffer;
-  uint8_t cursor;
-
-#elif PAYLOAD_ENCODER == 2 // format packed
+  friend struct PlainFormat;
+  friend struct PackedFormat;
+  template <bool Dynamic> friend struct LppFormat;
 
-private:
-  uint8_t *buffer;
-  uint8_t cursor;
-  void intToBytes(uint8_t pos, int32_t i, uint8_t byteSize);
-  void writeUptime(uint64_t unixtime);
-  void writeLatLng(double latitude, double longitude);
-  void writeUint32(uint32_t i);
-  void writeUint16(uint16_t i);
-  void writeUint8(uint8_t i);
-  void writeFloat(float value);
-  void writeUFloat(float value);
-  void writePressure(float value);
-  void writeVersion(char * version);
-  void writeBitmap(bool a, bool b, bool c, bool d, bool e, bool f, bool g,
-                   bool h);
-
-#elif (PAYLOAD_ENCODER == 3 || PAYLOAD_ENCODER == 4) // format cayenne lpp
-
-private:
   uint8_t *buffer;
   uint8_t maxsize;
   uint8_t cursor;
-
-#else
-#error "No valid payload converter defined"
-#endif
+  uint8_t format;
+
+  bool fits(uint16_t n) const { return cursor + n <= maxsize; }
+  bool refuse(uint16_t n);
+  void writeByte(uint8_t value) {
+    uint8_t *p = buffer + cursor++;
+    *p = value;
+  }
+  void writeBytes(const void *data, uint8_t n);
+  void writeBE(uint32_t value, uint8_t bytes);
+  void writeLE(uint32_t value, uint8_t bytes);
 };
 
 extern PayloadConvert payload;
@@ -0,0 +1,37 @@
+#ifndef _PERFSTATS_H
+#define _PERFSTATS_H
+
+#include <atomic>
+
+#include "globals.h"
+
+// Counters of the sniffer pipeline since device start. Each counter has one
+// writer task only, so it is incremented by relaxed atomic load and store,
+// which is a plain add without bus lock on the hot path, yet never torn
+// for the reader. Housekeeping turns them into rates per second, which
+// remote command 0x87 sends.
+
+#define PERF_WIFI_FRAMES 0        // Wifi frames handed over by driver
+#define PERF_WIFI_RSSI_DROPPED 1  // Wifi frames below RSSI limit
+#define PERF_BLE_ADVERTS 2        // BLE advertisements handed over by stack
+#define PERF_BLE_RSSI_DROPPED 3   // BLE advertisements below RSSI limit
+#define PERF_BLE_VENDOR_DROPPED 4 // BLE random addresses, see VENDORFILTER
+#define PERF_VENDOR_DROPPED 5     // Wifi MACs dropped by vendor filter
+#define PERF_RECORDS 6            // records counted by macloop task
+#define PERF_COUNT_US 7           // time spent counting records [us]
+#define PERF_COUNTERS 8
+
+extern std::atomic<uint32_t> perf_counters[PERF_COUNTERS];
+
+// call only from the task owning the counter, see above
+inline void perf_count(uint8_t counter, uint32_t n = 1) {
+  perf_counters[counter].store(
+      perf_counters[counter].load(std::memory_order_relaxed) + n,
+      std::memory_order_relaxed);
+}
+
+void perf_batch(uint16_t records, uint32_t us);
+void perf_update(void);
+void perf_get(perfStatus_t *stats);
+
+#endif
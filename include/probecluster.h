@@ -0,0 +1,50 @@
+#ifndef _PROBECLUSTER_H
+#define _PROBECLUSTER_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Clusters randomized MACs of probe requests which belong to one device.
+// Devices of the same model send the same fingerprint of information
+// elements, so a cluster is continued only if the 802.11 sequence number of
+// the new probe follows the last one within seqgap and the cluster was seen
+// within window. Each cluster keeps the first MAC seen, which is counted
+// for all its members. Clusters are filed in a set associative table by
+// fingerprint and sequence number block, so match() looks at two sets of
+// PROBE_WAYS entries, O(1); the least recently seen entry of a set is reused.
+// The class is not locked; it is meant for the single MAC counting task.
+
+#define PROBE_WAYS 4
+
+typedef struct {
+  uint32_t fingerprint; // hash of information elements, 0 = entry empty
+  uint32_t lastseen;    // [milliseconds]
+  uint16_t seq;         // last sequence number
+  uint8_t mac[6];       // first MAC of cluster
+} ProbeCluster_t;
+
+class ProbeClusters {
+
+public:
+  ProbeClusters(uint16_t entries, uint32_t window, uint16_t seqgap);
+  ~ProbeClusters();
+
+  const uint8_t *match(uint32_t fingerprint, uint16_t seq, const uint8_t *mac,
+                       uint32_t now);
+  uint32_t getProbes(void) const;
+  uint32_t getMerged(void) const;
+  void clear(void);
+
+private:
+  ProbeCluster_t *table;
+  uint16_t sets;
+  const uint32_t window;
+  const uint16_t seqgap;
+  uint32_t probes, merged;
+  ProbeCluster_t *set(uint32_t fingerprint, uint16_t block);
+  ProbeCluster_t *find(ProbeCluster_t *set, uint32_t fingerprint, uint16_t seq,
+                       uint32_t now, uint16_t *bestgap);
+  ProbeCluster_t *victim(ProbeCluster_t *set);
+};
+
+#endif
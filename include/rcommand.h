@@ -6,6 +6,7 @@
 #include "configmanager.h"
 #include "lorawan.h"
 #include "macsniff.h"
+#include "wifiscan.h"
 #include <rom/rtc.h>
 #include "cyclic.h"
 
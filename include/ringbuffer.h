@@ -0,0 +1,64 @@
+#ifndef _RINGBUFFER_H
+#define _RINGBUFFER_H
+
+#include <inttypes.h>
+#include <atomic>
+
+// Lock-free single producer / single consumer ring buffer.
+// push() must only be called by one producer context, pop() only by one
+// consumer context. N must be a power of two. Items which do not fit are
+// dropped and counted, the producer never blocks.
+
+template <class T, uint16_t N> class RingBuffer {
+
+  static_assert(N && !(N & (N - 1)), "RingBuffer size must be a power of 2");
+
+public:
+  RingBuffer() : head(0), tail(0), dropped(0), highwater(0) {}
+
+  // producer side, returns number of items in ring after push, or 0 if ring
+  // was full and item was dropped. 1 means the consumer may be sleeping.
+  uint16_t push(const T &item) {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    const uint32_t used = h - tail.load(std::memory_order_acquire);
+    if (used >= N) {
+      dropped++;
+      return 0;
+    }
+    items[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    if (used + 1 > highwater)
+      highwater = used + 1;
+    return (uint16_t)(used + 1);
+  }
+
+  // consumer side, copies up to max items to buf, returns number of items
+  uint16_t pop(T *buf, uint16_t max) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t avail = head.load(std::memory_order_acquire) - t;
+    if (avail > max)
+      avail = max;
+    for (uint32_t i = 0; i < avail; i++)
+      buf[i] = items[(t + i) & (N - 1)];
+    tail.store(t + avail, std::memory_order_release);
+    return (uint16_t)avail;
+  }
+
+  bool empty(void) const {
+    return head.load(std::memory_order_acquire) ==
+           tail.load(std::memory_order_acquire);
+  }
+
+  uint16_t capacity(void) const { return N; }
+  uint32_t getDropped(void) const { return dropped; }
+  uint16_t getHighwater(void) const { return highwater; }
+
+private:
+  T items[N];
+  std::atomic<uint32_t> head; // written by producer only
+  std::atomic<uint32_t> tail; // written by consumer only
+  volatile uint32_t dropped;  // written by producer only
+  volatile uint16_t highwater;
+};
+
+#endif
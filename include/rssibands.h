@@ -0,0 +1,39 @@
+#ifndef _RSSIBANDS_H
+#define _RSSIBANDS_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// Unique counts per distance band, by RSSI. Each 16bit MAC hash has a 2bit
+// code, so memory footprint is 16 KB regardless of number of devices seen:
+// 0 = not seen, or band of strongest signal received from device, i.e. the
+// maximum RSSI quantized to band. The maximum is robust against the fading
+// dips of a moving device, and the code only ever moves nearer, so counts
+// per band are kept up to date on each sighting and are read in O(1). The
+// class is not locked; callers in different tasks must serialize access.
+
+#define RSSIBANDS_BITS 65536
+#define RSSIBANDS_WORDS (RSSIBANDS_BITS / 16) // 16 codes per word
+
+#define RSSI_BAND_NEAR 0 // band indices
+#define RSSI_BAND_MID 1
+#define RSSI_BAND_FAR 2
+#define RSSI_BANDS 3 // code of band b is RSSI_BANDS - b
+
+class RssiBands {
+
+public:
+  RssiBands(int8_t near, int8_t mid);
+
+  void add(uint16_t hash, int8_t rssi);
+  uint16_t getCount(uint8_t band) const;
+  void setEdges(int8_t near, int8_t mid);
+  void clear(void);
+
+private:
+  uint32_t codes[RSSIBANDS_WORDS];
+  uint16_t counts[RSSI_BANDS + 1]; // indexed by code, 0 unused
+  int8_t near, mid;                // lower band edges [dBm]
+};
+
+#endif
@@ -4,10 +4,25 @@
 #include "spislave.h"
 #include "lorawan.h"
 #include "cyclic.h"
+#include "countseries.h"
+#include "sendscheduler.h"
 
 void SendPayload(uint8_t port);
+void beginAggregate(void);
+void sendAggregate(void);
 void sendCounter(void);
+void sendSketch(void);
+void sendWindows(void);
+void sendDwell(void);
+void sendBands(void);
+void sendVisits(void);
+bool sendSeries(const CountSample_t *sample, bool located);
+void sendBeaconAlarms(void);
 void checkSendQueues(void);
 void flushQueues();
 
+#ifdef COUNT_SERIES
+extern CountSeries countseries;
+#endif
+
 #endif // _SENDDATA_H_
\ No newline at end of file
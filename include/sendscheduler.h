@@ -0,0 +1,52 @@
+#ifndef _SENDSCHEDULER_H
+#define _SENDSCHEDULER_H
+
+#include "globals.h"
+
+// Send queue of one transport, holding up to size messages of four
+// priority classes. pop() hands out the oldest message of the most urgent
+// class. A message whose key covers all bits of the key of a queued
+// message of its class replaces that one in place, so superseded state,
+// like an older status reply, never goes out. When full, a new message
+// evicts the oldest one of the least urgent class below its own, else it
+// is dropped. Dropped and replaced messages are counted per class and
+// handed to the release function, which owns their buffers.
+
+#define SEND_ALARM 0     // beacon alarms, button
+#define SEND_RESPONSE 1  // results of remote commands
+#define SEND_COUNT 2     // counts and count statistics
+#define SEND_TELEMETRY 3 // GPS, sensors, battery
+#define SEND_CLASSES 4
+
+typedef void (*SendRelease_t)(MessageBuffer_t *message);
+
+class SendScheduler {
+
+public:
+  SendScheduler(uint8_t size, SendRelease_t release);
+  ~SendScheduler();
+
+  bool push(MessageBuffer_t *message);
+  MessageBuffer_t *pop(void);
+  uint8_t getCount(void) const;
+  const SendStats_t *getStats(uint8_t cls) const;
+  void clear(void);
+
+private:
+  typedef struct {
+    MessageBuffer_t *message; // NULL if slot is free
+    uint32_t order;           // sequence number of push
+  } SendSlot_t;
+
+  SendSlot_t *slots;
+  const uint8_t size;
+  uint8_t count;
+  uint32_t order;
+  SendRelease_t release;
+  SendStats_t stats[SEND_CLASSES];
+
+  int16_t oldest(uint8_t cls) const;
+  void remove(uint8_t i);
+};
+
+#endif
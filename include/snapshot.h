@@ -0,0 +1,34 @@
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "macbitmap.h"
+
+// Snapshot of the counting state, so a reset in the middle of a send cycle
+// does not count every device again. A header with magic, version, length,
+// epoch and CRC32 is followed by salt, counters and both dedup bitmaps, see
+// MacBitmap::save(). Decoding checks the header and CRC before it touches
+// the bitmaps, so a torn or stale snapshot is rejected as a whole.
+
+#define SNAPSHOT_MAGIC 0x50415853 // "PAXS"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER 16 // bytes
+#define SNAPSHOT_STATE 10  // bytes of salt and counters
+#define SNAPSHOT_MAX                                                           \
+  (SNAPSHOT_HEADER + SNAPSHOT_STATE + 2 * MACBITMAP_SAVED_MAX)
+
+typedef struct {
+  uint32_t epoch; // number of salt, see get_salt()
+  uint32_t salt;
+  uint16_t total, wifi, ble; // counters
+} Snapshot_t;
+
+size_t snapshot_encode(uint8_t *buf, size_t len, const Snapshot_t *state,
+                       const MacBitmap *wifi, const MacBitmap *ble);
+size_t snapshot_check(const uint8_t *buf, size_t len, uint32_t *epoch);
+bool snapshot_decode(const uint8_t *buf, size_t len, Snapshot_t *state,
+                     MacBitmap *wifi, MacBitmap *ble);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _VARINT_H
+#define _VARINT_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// LEB128 varints of up to 21 bits, 7 bits per byte, least significant
+// first, high bit set if more bytes follow. Used by serializers of
+// MacBitmap and CountSeries.
+
+#define VARINT_MAX 3 // bytes
+
+// append value as LEB128 varint if it fits, returns its size anyway
+static inline size_t put_varint(uint8_t *buf, size_t pos, size_t len,
+                                uint32_t value) {
+  size_t n = 0;
+  do {
+    const uint8_t byte = (value & 0x7F) | (value > 0x7F ? 0x80 : 0);
+    if (pos + n < len)
+      buf[pos + n] = byte;
+    n++;
+    value >>= 7;
+  } while (value);
+  return n;
+}
+
+// read LEB128 varint of up to 3 bytes, returns its size, 0 if invalid
+static inline size_t get_varint(const uint8_t *buf, size_t pos, size_t len,
+                                uint32_t *value) {
+  *value = 0;
+  for (size_t n = 0; (n < VARINT_MAX) && (pos + n < len); n++) {
+    *value |= (uint32_t)(buf[pos + n] & 0x7F) << (7 * n);
+    if (!(buf[pos + n] & 0x80))
+      return n + 1;
+  }
+  return 0;
+}
+
+// map signed to unsigned, so values close to zero get short varints
+static inline uint32_t zigzag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+#endif
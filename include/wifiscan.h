@@ -6,9 +6,37 @@
 
 // Hash function for scrambling MAC addresses
 #include "hash.h"
+#include "channelsched.h"
+
+// Wifi filter profiles, which senders are counted
+#define WIFI_FILTER_ALL 0     // senders of all frames
+#define WIFI_FILTER_CLIENTS 1 // probe and association requests, data to AP
+#define WIFI_FILTER_PROBES 2  // probe requests only
+
+// Wifi frame classes, by type, subtype and direction of frame
+#define WIFI_FRAME_PROBE 0   // probe request
+#define WIFI_FRAME_ASSOC 1   // (re)association request
+#define WIFI_FRAME_TODS 2    // data frame to access point
+#define WIFI_FRAME_MGMT 3    // other management, e.g. authentication, action
+#define WIFI_FRAME_AP 4      // beacon, probe/association response, data from AP
+#define WIFI_FRAME_DATA 5    // data frame neither to nor from AP, e.g. WDS
+#define WIFI_FRAME_CTRL 6    // control frame
+#define WIFI_FRAME_GROUP 7   // group sender address, invalid
+#define WIFI_FRAME_CLASSES 8
+
+extern ChannelScheduler channelsched;
 
 void wifi_sniffer_init(void);
 void IRAM_ATTR wifi_sniffer_packet_handler(void *buff, wifi_promiscuous_pkt_type_t type);
 void switchWifiChannel(void * parameter);
+void wifi_filter_set(uint8_t profile);
+uint32_t wifi_frames(uint8_t frameclass);
+#ifdef PROBE_FINGERPRINT
+uint32_t probe_fingerprint(const uint8_t *ie, uint16_t len);
+#endif
+bool wifi_filter_passes(uint8_t frameclass);
+void channel_switch(void);
+void channel_hit(uint8_t ch);
+uint8_t channel_stats(uint16_t yield[], uint8_t share[]);
 
 #endif
\ No newline at end of file
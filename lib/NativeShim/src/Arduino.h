@@ -0,0 +1,83 @@
+#ifndef _NATIVESHIM_ARDUINO_H
+#define _NATIVESHIM_ARDUINO_H
+
+// Stand-in for arduino-esp32 core on a Linux host, covers only what the
+// counting and payload core uses
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+
+#include "freertos_shim.h"
+
+#define IRAM_ATTR
+#define DMA_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define PROGMEM
+
+#define NOT_A_PIN 255
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+
+typedef uint8_t byte;
+
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define lowByte(w) ((uint8_t)((w)&0xff))
+#define strcat_P strcat
+#define PSTR(s) (s)
+#define strcpy_P strcpy
+
+// ESP_LOGx print to stdout up to LOG_LOCAL_LEVEL, tag is ignored like in
+// arduino-esp32 core
+#ifndef LOG_LOCAL_LEVEL
+#define LOG_LOCAL_LEVEL 3
+#endif
+
+#define ESP_LOG_NATIVE(level, letter, format, ...)                            \
+  do {                                                                         \
+    if (LOG_LOCAL_LEVEL >= level)                                              \
+      printf("[" letter "] " format "\n", ##__VA_ARGS__);                      \
+  } while (0)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_NATIVE(1, "E", format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_NATIVE(2, "W", format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_NATIVE(3, "I", format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_NATIVE(4, "D", format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOG_NATIVE(5, "V", format, ##__VA_ARGS__)
+#define ESP_LOG_BUFFER_HEXDUMP(...)                                            \
+  do {                                                                         \
+  } while (0)
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERROR_CHECK(x) (void)(x)
+#define ESP_ERROR_CHECK_WITHOUT_ABORT(x) (void)(x)
+
+unsigned long millis(void);
+void delay(uint32_t ms);
+long random(long max);
+uint32_t esp_random(void);
+void esp_restart(void);
+float temperatureRead(void);
+
+typedef struct hw_timer_s hw_timer_t;
+void timerAlarmWrite(hw_timer_t *timer, uint64_t alarm, bool autoreload);
+
+class EspClass {
+public:
+  uint32_t getFreeHeap(void);
+  uint32_t getMinFreeHeap(void);
+  uint32_t getFreePsram(void);
+  uint32_t getMinFreePsram(void);
+};
+
+extern EspClass ESP;
+
+#endif
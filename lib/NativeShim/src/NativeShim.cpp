@@ -0,0 +1,434 @@
+// Host implementation of the Arduino, FreeRTOS, ESP-IDF and LMIC calls
+// declared in the shim headers. Tasks run as detached threads, task
+// notifications and queues are built on mutex and condition variable.
+
+#include "Arduino.h"
+#include "esp_bt.h"
+#include "esp_bt_main.h"
+#include "esp_coexist.h"
+#include "esp_gap_ble_api.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "esp32-hal-psram.h"
+#include "nvs_flash.h"
+#include "lmic.h"
+#include "rom/rtc.h"
+#include "rom/crc.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+/* ---------------- Arduino / ESP ---------------- */
+
+int64_t esp_timer_get_time(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+unsigned long millis(void) { return esp_timer_get_time() / 1000; }
+
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// fixed seed, so runs are reproducible
+static std::mt19937 rng(0x50415843);
+static std::mutex rngMutex;
+
+uint32_t esp_random(void) {
+  std::lock_guard<std::mutex> lock(rngMutex);
+  return rng();
+}
+
+long random(long max) { return max > 0 ? esp_random() % max : 0; }
+
+void esp_restart(void) {
+  printf("esp_restart() called, exiting\n");
+  exit(0);
+}
+
+float temperatureRead(void) { return 25.0; }
+
+bool psramFound(void) { return false; }
+
+void timerAlarmWrite(hw_timer_t *timer, uint64_t alarm, bool autoreload) {}
+
+RESET_REASON native_reset_reason = POWERON_RESET;
+
+RESET_REASON rtc_get_reset_reason(int cpu) { return native_reset_reason; }
+
+uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (uint8_t k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+EspClass ESP;
+uint32_t EspClass::getFreeHeap(void) { return 100000; }
+uint32_t EspClass::getMinFreeHeap(void) { return 100000; }
+uint32_t EspClass::getFreePsram(void) { return 0; }
+uint32_t EspClass::getMinFreePsram(void) { return 0; }
+
+/* ---------------- Wifi ---------------- */
+
+// no radio, frames are fed to the promiscuous callback by the caller
+esp_err_t esp_coex_preference_set(esp_coex_prefer_t prefer) { return ESP_OK; }
+esp_err_t esp_wifi_init(const wifi_init_config_t *config) { return ESP_OK; }
+esp_err_t esp_wifi_set_country(const wifi_country_t *country) {
+  return ESP_OK;
+}
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage) { return ESP_OK; }
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode) { return ESP_OK; }
+esp_err_t esp_wifi_stop(void) { return ESP_OK; }
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t *f) {
+  return ESP_OK;
+}
+esp_err_t esp_wifi_set_promiscuous_rx_cb(
+    void (*cb)(void *, wifi_promiscuous_pkt_type_t)) {
+  return ESP_OK;
+}
+esp_err_t esp_wifi_set_promiscuous(bool enable) { return ESP_OK; }
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+  return ESP_OK;
+}
+
+/* ---------------- Bluetooth ---------------- */
+
+// no radio, advertisements are fed to the GAP callback by the caller
+void btStart(void) {}
+void btStop(void) {}
+esp_err_t esp_bluedroid_init(void) { return ESP_OK; }
+esp_err_t esp_bluedroid_enable(void) { return ESP_OK; }
+esp_err_t esp_bluedroid_disable(void) { return ESP_OK; }
+esp_err_t esp_bluedroid_deinit(void) { return ESP_OK; }
+esp_err_t esp_ble_gap_register_callback(
+    void (*cb)(esp_gap_ble_cb_event_t, esp_ble_gap_cb_param_t *)) {
+  return ESP_OK;
+}
+esp_err_t esp_ble_gap_set_scan_params(esp_ble_scan_params_t *params) {
+  return ESP_OK;
+}
+esp_err_t esp_ble_gap_start_scanning(uint32_t duration) { return ESP_OK; }
+
+/* ---------------- LMIC ---------------- */
+
+void LMIC_shutdown(void) {}
+void LMIC_setAdrMode(bool enabled) {}
+void LMIC_setDrTxpow(uint8_t dr, int8_t txpow) {}
+void LMIC_requestNetworkTime(void (*callback)(void *, int), void *user) {}
+
+/* ---------------- FreeRTOS ---------------- */
+
+void vPortEnterCritical(portMUX_TYPE *mux) {
+  while (__atomic_test_and_set(&mux->locked, __ATOMIC_ACQUIRE))
+    ;
+}
+
+void vPortExitCritical(portMUX_TYPE *mux) {
+  __atomic_clear(&mux->locked, __ATOMIC_RELEASE);
+}
+
+typedef struct {
+  std::mutex mutex;
+  std::condition_variable cv;
+  uint32_t value;
+} NativeTask_t;
+
+static thread_local NativeTask_t *currentTask = NULL;
+
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *name,
+                                   uint32_t stack, void *param,
+                                   UBaseType_t prio, TaskHandle_t *handle,
+                                   BaseType_t core) {
+  NativeTask_t *t = new NativeTask_t();
+  t->value = 0;
+  if (handle)
+    *handle = t;
+  std::thread([t, task, param]() {
+    currentTask = t;
+    task(param);
+  }).detach();
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {}
+
+// threads not created by xTaskCreatePinnedToCore() get their handle here,
+// like the main task of the device
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+  if (!currentTask) {
+    currentTask = new NativeTask_t();
+    currentTask->value = 0;
+  }
+  return currentTask;
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+
+TickType_t xTaskGetTickCount(void) { return millis() / portTICK_PERIOD_MS; }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { return 0; }
+
+eTaskState eTaskGetState(TaskHandle_t task) { return eReady; }
+
+// wait for notification, returns with lock held if notified
+static bool notify_wait(NativeTask_t *t, std::unique_lock<std::mutex> &lock,
+                        TickType_t wait) {
+  if (wait == portMAX_DELAY)
+    t->cv.wait(lock, [t] { return t->value != 0; });
+  else
+    t->cv.wait_for(lock, std::chrono::milliseconds(wait),
+                   [t] { return t->value != 0; });
+  return t->value != 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) {
+  NativeTask_t *t = currentTask;
+  if (!t) {
+    delay(wait);
+    return 0;
+  }
+  std::unique_lock<std::mutex> lock(t->mutex);
+  notify_wait(t, lock, wait);
+  uint32_t value = t->value;
+  if (value)
+    t->value = clear ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clearentry, uint32_t clearexit,
+                           uint32_t *value, TickType_t wait) {
+  NativeTask_t *t = currentTask;
+  if (!t)
+    return pdFALSE;
+  std::unique_lock<std::mutex> lock(t->mutex);
+  t->value &= ~clearentry;
+  bool notified = notify_wait(t, lock, wait);
+  if (value)
+    *value = t->value;
+  t->value &= ~clearexit;
+  return notified ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action) {
+  NativeTask_t *t = (NativeTask_t *)task;
+  if (!t)
+    return pdFALSE;
+  {
+    std::lock_guard<std::mutex> lock(t->mutex);
+    if (action == eSetBits)
+      t->value |= value;
+    else if (action == eIncrement)
+      t->value++;
+  }
+  t->cv.notify_one();
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value,
+                              eNotifyAction action, BaseType_t *woken) {
+  return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  return xTaskNotify(task, 0, eIncrement);
+}
+
+typedef struct {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::vector<uint8_t>> items;
+  UBaseType_t length, itemsize;
+} NativeQueue_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemsize) {
+  NativeQueue_t *q = new NativeQueue_t();
+  q->length = length;
+  q->itemsize = itemsize;
+  return q;
+}
+
+static BaseType_t queue_send(QueueHandle_t queue, const void *item,
+                             bool front) {
+  NativeQueue_t *q = (NativeQueue_t *)queue;
+  {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    if (q->items.size() >= q->length)
+      return pdFALSE; // no blocking send on host
+    std::vector<uint8_t> v((const uint8_t *)item,
+                           (const uint8_t *)item + q->itemsize);
+    if (front)
+      q->items.push_front(v);
+    else
+      q->items.push_back(v);
+  }
+  q->cv.notify_one();
+  return pdTRUE;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item,
+                            TickType_t wait) {
+  return queue_send(queue, item, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item,
+                             TickType_t wait) {
+  return queue_send(queue, item, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait) {
+  NativeQueue_t *q = (NativeQueue_t *)queue;
+  std::unique_lock<std::mutex> lock(q->mutex);
+  if (wait == portMAX_DELAY)
+    q->cv.wait(lock, [q] { return !q->items.empty(); });
+  else
+    q->cv.wait_for(lock, std::chrono::milliseconds(wait),
+                   [q] { return !q->items.empty(); });
+  if (q->items.empty())
+    return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemsize);
+  q->items.pop_front();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+  NativeQueue_t *q = (NativeQueue_t *)queue;
+  std::lock_guard<std::mutex> lock(q->mutex);
+  q->items.clear();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  NativeQueue_t *q = (NativeQueue_t *)queue;
+  std::lock_guard<std::mutex> lock(q->mutex);
+  return q->items.size();
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+  NativeQueue_t *q = (NativeQueue_t *)queue;
+  std::lock_guard<std::mutex> lock(q->mutex);
+  return q->length - q->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  return new std::timed_mutex();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait) {
+  std::timed_mutex *m = (std::timed_mutex *)sem;
+  if (wait == portMAX_DELAY) {
+    m->lock();
+    return pdTRUE;
+  }
+  return m->try_lock_for(std::chrono::milliseconds(wait)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  ((std::timed_mutex *)sem)->unlock();
+  return pdTRUE;
+}
+
+/* ---------------- NVS ---------------- */
+
+static std::map<std::string, std::vector<uint8_t>> nvs;
+static std::mutex nvsMutex;
+
+esp_err_t nvs_flash_init(void) { return ESP_OK; }
+
+esp_err_t nvs_flash_erase(void) {
+  std::lock_guard<std::mutex> lock(nvsMutex);
+  nvs.clear();
+  return ESP_OK;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode mode, nvs_handle *handle) {
+  *handle = 1; // one namespace only
+  return ESP_OK;
+}
+
+void nvs_close(nvs_handle handle) {}
+
+esp_err_t nvs_commit(nvs_handle handle) { return ESP_OK; }
+
+esp_err_t nvs_erase_all(nvs_handle handle) { return nvs_flash_erase(); }
+
+esp_err_t nvs_erase_key(nvs_handle handle, const char *key) {
+  std::lock_guard<std::mutex> lock(nvsMutex);
+  return nvs.erase(key) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+static esp_err_t nvs_set(const char *key, const void *value, size_t length) {
+  std::lock_guard<std::mutex> lock(nvsMutex);
+  nvs[key].assign((const uint8_t *)value, (const uint8_t *)value + length);
+  return ESP_OK;
+}
+
+// length in: buffer size, out: stored size; value NULL queries size only
+static esp_err_t nvs_get(const char *key, void *value, size_t *length) {
+  std::lock_guard<std::mutex> lock(nvsMutex);
+  auto it = nvs.find(key);
+  if (it == nvs.end())
+    return ESP_ERR_NVS_NOT_FOUND;
+  if (value) {
+    if (*length < it->second.size())
+      return ESP_FAIL;
+    memcpy(value, it->second.data(), it->second.size());
+  }
+  *length = it->second.size();
+  return ESP_OK;
+}
+
+esp_err_t nvs_get_i8(nvs_handle handle, const char *key, int8_t *value) {
+  size_t length = sizeof(int8_t);
+  return nvs_get(key, value, &length);
+}
+
+esp_err_t nvs_get_i16(nvs_handle handle, const char *key, int16_t *value) {
+  size_t length = sizeof(int16_t);
+  return nvs_get(key, value, &length);
+}
+
+esp_err_t nvs_get_str(nvs_handle handle, const char *key, char *value,
+                      size_t *length) {
+  return nvs_get(key, value, length);
+}
+
+esp_err_t nvs_get_blob(nvs_handle handle, const char *key, void *value,
+                       size_t *length) {
+  return nvs_get(key, value, length);
+}
+
+esp_err_t nvs_set_i8(nvs_handle handle, const char *key, int8_t value) {
+  return nvs_set(key, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_i16(nvs_handle handle, const char *key, int16_t value) {
+  return nvs_set(key, &value, sizeof(value));
+}
+
+esp_err_t nvs_set_str(nvs_handle handle, const char *key, const char *value) {
+  return nvs_set(key, value, strlen(value) + 1);
+}
+
+esp_err_t nvs_set_blob(nvs_handle handle, const char *key, const void *value,
+                       size_t length) {
+  if (length > NVS_BLOB_MAX)
+    return ESP_ERR_NVS_VALUE_TOO_LONG;
+  return nvs_set(key, value, length);
+}
@@ -0,0 +1,3 @@
+#ifndef _NATIVESHIM_SPI_H
+#define _NATIVESHIM_SPI_H
+#endif
@@ -0,0 +1,16 @@
+#ifndef _NATIVESHIM_TIME_H
+#define _NATIVESHIM_TIME_H
+
+// declarations of Time library as used by the core, not implemented
+
+#include <time.h>
+
+typedef enum { timeNotSet, timeNeedsSync, timeSet } timeStatus_t;
+
+time_t now(void);
+timeStatus_t timeStatus(void);
+void setTime(time_t t);
+void setSyncProvider(time_t (*provider)());
+void setSyncInterval(time_t interval);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef _NATIVESHIM_TIMEZONE_H
+#define _NATIVESHIM_TIMEZONE_H
+
+#include "Time.h"
+#include <stdint.h>
+
+enum week_t { Last, First, Second, Third, Fourth };
+enum dow_t { Sun = 1, Mon, Tue, Wed, Thu, Fri, Sat };
+enum month_t { Jan = 1, Feb, Mar, Apr, May, Jun, Jul, Aug, Sep, Oct, Nov, Dec };
+
+struct TimeChangeRule {
+  char abbrev[6];
+  uint8_t week;
+  uint8_t dow;
+  uint8_t month;
+  uint8_t hour;
+  int offset;
+};
+
+// no time zone conversion on host, local time is UTC
+class Timezone {
+public:
+  Timezone(TimeChangeRule dst, TimeChangeRule std) {}
+  time_t toLocal(time_t utc) { return utc; }
+};
+
+#endif
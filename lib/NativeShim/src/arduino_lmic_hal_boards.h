@@ -0,0 +1,3 @@
+#ifndef _NATIVESHIM_LMIC_HAL_BOARDS_H
+#define _NATIVESHIM_LMIC_HAL_BOARDS_H
+#endif
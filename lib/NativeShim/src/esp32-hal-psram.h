@@ -0,0 +1,9 @@
+#ifndef _NATIVESHIM_PSRAM_H
+#define _NATIVESHIM_PSRAM_H
+
+#include <stdlib.h>
+
+static inline void *ps_malloc(size_t size) { return malloc(size); }
+bool psramFound(void);
+
+#endif
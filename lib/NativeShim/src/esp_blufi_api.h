@@ -0,0 +1,3 @@
+#ifndef _NATIVESHIM_ESP_BLUFI_API_H
+#define _NATIVESHIM_ESP_BLUFI_API_H
+#endif
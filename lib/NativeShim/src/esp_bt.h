@@ -0,0 +1,10 @@
+#ifndef _NATIVESHIM_ESP_BT_H
+#define _NATIVESHIM_ESP_BT_H
+
+#include "Arduino.h"
+
+typedef enum { ESP_BT_MODE_BTDM } esp_bt_mode_t;
+void btStart(void);
+void btStop(void);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef _NATIVESHIM_ESP_BT_MAIN_H
+#define _NATIVESHIM_ESP_BT_MAIN_H
+
+#include "Arduino.h"
+esp_err_t esp_bluedroid_init(void);
+esp_err_t esp_bluedroid_enable(void);
+esp_err_t esp_bluedroid_disable(void);
+esp_err_t esp_bluedroid_deinit(void);
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef _NATIVESHIM_ESP_COEXIST_H
+#define _NATIVESHIM_ESP_COEXIST_H
+
+#include "Arduino.h"
+
+typedef enum {
+  ESP_COEX_PREFER_WIFI,
+  ESP_COEX_PREFER_BT,
+  ESP_COEX_PREFER_BALANCE
+} esp_coex_prefer_t;
+
+esp_err_t esp_coex_preference_set(esp_coex_prefer_t prefer);
+
+#endif
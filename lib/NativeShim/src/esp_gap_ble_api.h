@@ -0,0 +1,27 @@
+#ifndef _NATIVESHIM_ESP_GAP_BLE_API_H
+#define _NATIVESHIM_ESP_GAP_BLE_API_H
+
+#include "Arduino.h"
+typedef uint8_t esp_bd_addr_t[6];
+typedef enum { BLE_ADDR_TYPE_PUBLIC, BLE_ADDR_TYPE_RANDOM, BLE_ADDR_TYPE_RPA_PUBLIC, BLE_ADDR_TYPE_RPA_RANDOM } esp_ble_addr_type_t;
+typedef enum { ESP_GAP_BLE_SCAN_RESULT_EVT = 3, ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT = 2 } esp_gap_ble_cb_event_t;
+typedef enum { ESP_GAP_SEARCH_INQ_RES_EVT, ESP_GAP_SEARCH_INQ_CMPL_EVT } esp_gap_search_evt_t;
+typedef enum { ESP_BLE_EVT_CONN_ADV, ESP_BLE_EVT_CONN_DIR_ADV, ESP_BLE_EVT_DISC_ADV, ESP_BLE_EVT_NON_CONN_ADV, ESP_BLE_EVT_SCAN_RSP } esp_ble_evt_type_t;
+#define ESP_BLE_ADV_DATA_LEN_MAX 31
+#define ESP_BLE_SCAN_RSP_DATA_LEN_MAX 31
+typedef union {
+  struct ble_scan_result_evt_param {
+    esp_gap_search_evt_t search_evt; esp_bd_addr_t bda; int dev_type; esp_ble_addr_type_t ble_addr_type;
+    esp_ble_evt_type_t ble_evt_type; int rssi;
+    uint8_t ble_adv[ESP_BLE_ADV_DATA_LEN_MAX + ESP_BLE_SCAN_RSP_DATA_LEN_MAX];
+    int flag; int num_resps; uint8_t adv_data_len; uint8_t scan_rsp_len;
+  } scan_rst;
+} esp_ble_gap_cb_param_t;
+typedef enum { BLE_SCAN_TYPE_PASSIVE, BLE_SCAN_TYPE_ACTIVE } esp_ble_scan_type_t;
+typedef enum { BLE_SCAN_FILTER_ALLOW_ALL, BLE_SCAN_FILTER_ALLOW_ONLY_WLST, BLE_SCAN_FILTER_ALLOW_UND_RPA_DIR, BLE_SCAN_FILTER_ALLOW_WLIST_PRA_DIR } esp_ble_scan_filter_t;
+typedef struct { esp_ble_scan_type_t scan_type; esp_ble_addr_type_t own_addr_type; esp_ble_scan_filter_t scan_filter_policy; uint16_t scan_interval; uint16_t scan_window; } esp_ble_scan_params_t;
+esp_err_t esp_ble_gap_register_callback(void (*)(esp_gap_ble_cb_event_t, esp_ble_gap_cb_param_t *));
+esp_err_t esp_ble_gap_set_scan_params(esp_ble_scan_params_t *);
+esp_err_t esp_ble_gap_start_scanning(uint32_t);
+
+#endif
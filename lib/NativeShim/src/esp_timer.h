@@ -0,0 +1,8 @@
+#ifndef _NATIVESHIM_ESP_TIMER_H
+#define _NATIVESHIM_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void); // [microseconds] since program start
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef _NATIVESHIM_ESP_WIFI_H
+#define _NATIVESHIM_ESP_WIFI_H
+
+#include "Arduino.h"
+typedef struct {
+  signed rssi : 8; unsigned rate : 5; unsigned : 1; unsigned sig_mode : 2; unsigned : 16;
+  unsigned mcs : 7; unsigned cwb : 1; unsigned : 16; unsigned smoothing : 1; unsigned not_sounding : 1;
+  unsigned : 1; unsigned aggregation : 1; unsigned stbc : 2; unsigned fec_coding : 1; unsigned sgi : 1;
+  signed noise_floor : 8; unsigned ampdu_cnt : 8; unsigned channel : 4; unsigned secondary_channel : 4;
+  unsigned : 8; unsigned timestamp : 32; unsigned : 32; unsigned : 31; unsigned ant : 1;
+  unsigned sig_len : 12; unsigned : 12; unsigned rx_state : 8;
+} wifi_pkt_rx_ctrl_t;
+typedef struct { wifi_pkt_rx_ctrl_t rx_ctrl; uint8_t payload[0]; } wifi_promiscuous_pkt_t;
+typedef enum { WIFI_PKT_MGMT, WIFI_PKT_CTRL, WIFI_PKT_DATA, WIFI_PKT_MISC } wifi_promiscuous_pkt_type_t;
+#define WIFI_PROMIS_FILTER_MASK_ALL 0xFFFFFFFF
+#define WIFI_PROMIS_FILTER_MASK_MGMT (1)
+#define WIFI_PROMIS_FILTER_MASK_CTRL (1<<1)
+#define WIFI_PROMIS_FILTER_MASK_DATA (1<<2)
+typedef struct { uint32_t filter_mask; } wifi_promiscuous_filter_t;
+typedef enum { WIFI_COUNTRY_POLICY_AUTO, WIFI_COUNTRY_POLICY_MANUAL } wifi_country_policy_t;
+typedef struct { char cc[3]; uint8_t schan; uint8_t nchan; int8_t max_tx_power; wifi_country_policy_t policy; } wifi_country_t;
+typedef struct { int nvs_enable; int wifi_task_core_id; } wifi_init_config_t;
+#define WIFI_INIT_CONFIG_DEFAULT() {0, 0}
+typedef enum { WIFI_STORAGE_FLASH, WIFI_STORAGE_RAM } wifi_storage_t;
+typedef enum { WIFI_MODE_NULL } wifi_mode_t;
+typedef enum { WIFI_SECOND_CHAN_NONE } wifi_second_chan_t;
+esp_err_t esp_wifi_init(const wifi_init_config_t *);
+esp_err_t esp_wifi_set_country(const wifi_country_t *);
+esp_err_t esp_wifi_set_storage(wifi_storage_t);
+esp_err_t esp_wifi_set_mode(wifi_mode_t);
+esp_err_t esp_wifi_stop(void);
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t *);
+esp_err_t esp_wifi_set_promiscuous_rx_cb(void (*)(void *, wifi_promiscuous_pkt_type_t));
+esp_err_t esp_wifi_set_promiscuous(bool);
+esp_err_t esp_wifi_set_channel(uint8_t, wifi_second_chan_t);
+
+#endif
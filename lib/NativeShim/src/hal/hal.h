@@ -0,0 +1,8 @@
+#ifndef _NATIVESHIM_HAL_HAL_H
+#define _NATIVESHIM_HAL_HAL_H
+
+struct lmic_pinmap {
+  int unused;
+};
+
+#endif
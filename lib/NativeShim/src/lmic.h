@@ -0,0 +1,27 @@
+#ifndef _NATIVESHIM_LMIC_H
+#define _NATIVESHIM_LMIC_H
+
+// LMIC types and calls referenced by the core; native build has no LoRa
+
+#include "Arduino.h"
+
+typedef uint8_t u1_t;
+typedef uint16_t u2_t;
+typedef uint32_t u4_t;
+typedef int32_t ostime_t;
+typedef uint8_t ev_t;
+
+typedef struct osjob_t osjob_t;
+typedef void (*osjobcb_t)(osjob_t *job);
+struct osjob_t {
+  osjob_t *next;
+  ostime_t deadline;
+  osjobcb_t func;
+};
+
+void LMIC_shutdown(void);
+void LMIC_setAdrMode(bool enabled);
+void LMIC_setDrTxpow(uint8_t dr, int8_t txpow);
+void LMIC_requestNetworkTime(void (*callback)(void *, int), void *user);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef _NATIVESHIM_LORACONF_H
+#define _NATIVESHIM_LORACONF_H
+
+// native build has no LoRa, keys are not used
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef _NATIVESHIM_NVS_H
+#define _NATIVESHIM_NVS_H
+
+// NVS key value store, kept in RAM for the lifetime of the process
+
+#include "Arduino.h"
+
+typedef uint32_t nvs_handle;
+typedef enum { NVS_READONLY, NVS_READWRITE } nvs_open_mode;
+#define ESP_ERR_NVS_BASE 0x1100
+#define ESP_ERR_NVS_NOT_FOUND (ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_NO_FREE_PAGES (ESP_ERR_NVS_BASE + 0x0d)
+#define ESP_ERR_NVS_VALUE_TOO_LONG (ESP_ERR_NVS_BASE + 0x0e)
+#define NVS_BLOB_MAX 1984 // bytes, blobs do not span pages before IDF 3.2
+esp_err_t nvs_open(const char *name, nvs_open_mode mode, nvs_handle *handle);
+void nvs_close(nvs_handle handle);
+esp_err_t nvs_commit(nvs_handle handle);
+esp_err_t nvs_erase_all(nvs_handle handle);
+esp_err_t nvs_erase_key(nvs_handle handle, const char *key);
+esp_err_t nvs_get_i8(nvs_handle handle, const char *key, int8_t *value);
+esp_err_t nvs_get_i16(nvs_handle handle, const char *key, int16_t *value);
+esp_err_t nvs_get_str(nvs_handle handle, const char *key, char *value,
+                      size_t *length);
+esp_err_t nvs_get_blob(nvs_handle handle, const char *key, void *value,
+                       size_t *length);
+esp_err_t nvs_set_i8(nvs_handle handle, const char *key, int8_t value);
+esp_err_t nvs_set_i16(nvs_handle handle, const char *key, int16_t value);
+esp_err_t nvs_set_str(nvs_handle handle, const char *key, const char *value);
+esp_err_t nvs_set_blob(nvs_handle handle, const char *key, const void *value,
+                       size_t length);
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef _NATIVESHIM_ROM_CRC_H
+#define _NATIVESHIM_ROM_CRC_H
+
+#include <stdint.h>
+
+// CRC32 as in ESP32 ROM, crc32_le(0, buf, len) gives the usual CRC-32
+uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+#endif
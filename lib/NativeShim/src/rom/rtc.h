@@ -0,0 +1,10 @@
+#ifndef _NATIVESHIM_ROM_RTC_H
+#define _NATIVESHIM_ROM_RTC_H
+
+typedef enum { NO_MEAN = 0, POWERON_RESET = 1, SW_CPU_RESET = 12 } RESET_REASON;
+
+RESET_REASON rtc_get_reset_reason(int cpu);
+
+extern RESET_REASON native_reset_reason; // returned by rtc_get_reset_reason()
+
+#endif
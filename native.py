@@ -0,0 +1,7 @@
+# native.py
+# pre-build script of the native host build, linking the std::thread tasks
+# of lib/NativeShim (link flags do not belong in build_flags)
+
+Import("env")
+
+env.Append(LIBS=["pthread"])
@@ -10,6 +10,12 @@ function Decoder(bytes, port) {
     }
 
     if (port === 1) {
+        // counter data followed by flags byte, if counts are estimated
+        if ([3, 5, 7, 16, 18, 20].indexOf(bytes.length) >= 0) {
+            decoded = Decoder(bytes.slice(0, bytes.length - 1), port);
+            decoded.estimated = bytes[bytes.length - 1];
+            return decoded;
+        }
         // only wifi counter data, no gps
         if (bytes.length === 2) {
             return decode(bytes, [uint16], ['wifi']);
@@ -26,6 +32,16 @@ function Decoder(bytes, port) {
         if (bytes.length === 17) {
             return decode(bytes, [uint16, uint16, latLng, latLng, uint8, hdop, uint16], ['wifi', 'ble', 'latitude', 'longitude', 'sats', 'hdop', 'altitude']);
         }
+        // wifi + ble + both counter data, with or without gps
+        if (bytes.length === 6 || bytes.length === 19) {
+            decoded = bytes.length === 6 ?
+                decode(bytes, [uint16, uint16, uint16], ['wifi', 'ble', 'both']) :
+                decode(bytes, [uint16, uint16, uint16, latLng, latLng, uint8, hdop, uint16], ['wifi', 'ble', 'both', 'latitude', 'longitude', 'sats', 'hdop', 'altitude']);
+            decoded.wifionly = decoded.wifi - decoded.both;
+            decoded.bleonly = decoded.ble - decoded.both;
+            decoded.pax = decoded.wifi + decoded.ble - decoded.both;
+            return decoded;
+        }
     }
 
     if (port === 2) {
@@ -35,7 +51,7 @@ function Decoder(bytes, port) {
 
     if (port === 3) {
         // device config data      
-        return decode(bytes, [uint8, uint8, uint16, uint8, uint8, uint8, uint8, bitmap1, bitmap2, version], ['lorasf', 'txpower', 'rssilimit', 'sendcycle', 'wifichancycle', 'blescantime', 'rgblum', 'flags', 'payloadmask', 'version']);
+        return decode(bytes, [uint8, uint8, int16, uint8, uint8, uint8, uint8, bitmap1, bitmap2, version], ['lorasf', 'txpower', 'rssilimit', 'sendcycle', 'wifichancycle', 'blescantime', 'rgblum', 'flags', 'payloadmask', 'version']);
     }
 
     if (port === 4) {
@@ -49,8 +65,13 @@ function Decoder(bytes, port) {
     }
 
     if (port === 6) {
-        // beacon proximity alarm      
-        return decode(bytes, [uint8, uint8], ['rssi', 'beacon']);
+        // beacon proximity alarm, 2 bytes per beacon
+        decoded = decode(bytes, [int8, uint8], ['rssi', 'beacon']);
+        decoded.alarms = [];
+        for (var i = 0; i + 2 <= bytes.length; i += 2) {
+            decoded.alarms.push(decode(bytes.slice(i, i + 2), [int8, uint8], ['rssi', 'beacon']));
+        }
+        return decoded;
     }
 
     if (port === 7) {
@@ -63,6 +84,114 @@ function Decoder(bytes, port) {
         return decode(bytes, [uint16], ['voltage']);
     }
 
+    if (port === 9) {
+        // HyperLogLog sketch registers
+        decoded = decode(bytes, [uint8, uint8], ['precision', 'offset']);
+        decoded.registers = bytes.slice(2);
+        return decoded;
+    }
+
+    if (port === 13) {
+        // sliding window counts, 3 bytes per window
+        for (var i = 0; i + 3 <= bytes.length; i += 3) {
+            decoded['pax' + bytes[i] + 'min'] = uint16(bytes.slice(i + 1, i + 3));
+        }
+        return decoded;
+    }
+
+    if (port === 14) {
+        // dwell time histogram, 2 bytes per bin
+        decoded.dwell = [];
+        for (var i = 0; i + 2 <= bytes.length; i += 2) {
+            decoded.dwell.push(uint16(bytes.slice(i, i + 2)));
+        }
+        return decoded;
+    }
+
+    if (port === 15) {
+        // wifi channel statistics, 3 bytes per channel
+        decoded.channels = [];
+        for (var i = 0; i + 3 <= bytes.length; i += 3) {
+            decoded.channels.push({
+                'yield': uint16(bytes.slice(i, i + 2)),
+                'share': uint8(bytes.slice(i + 2, i + 3))
+            });
+        }
+        return decoded;
+    }
+
+    if (port === 16) {
+        // unique counts per RSSI band
+        return decode(bytes, [uint16, uint16, uint16], ['near', 'mid', 'far']);
+    }
+
+    if (port === 17) {
+        // new, returning and departed devices
+        return decode(bytes, [uint16, uint16, uint16], ['new', 'returning', 'departed']);
+    }
+
+    if (port === 18) {
+        // sniffer performance counters
+        return decode(bytes, [uint16, uint16, uint16, uint16, uint16, uint16, uint16, uint16],
+            ['wififrames', 'bleadverts', 'rssidropped', 'vendordropped', 'ringdropped',
+                'collisions', 'insertns', 'batchmaxus']);
+    }
+
+    if (port === 20) {
+        // counts of send cycles kept while LoRa was busy: sequence number of
+        // first cycle, content bits, number of cycles, then per cycle counts,
+        // raw or as deltas to predecessor in zigzag LEB128 varints, and flags
+        var pos = 3, content = bytes[1];
+        var fields = ['wifi'], last = {};
+        var varint = function () {
+            var v = 0, shift = 0, b;
+            do {
+                b = bytes[pos++];
+                v += (b & 0x7F) * Math.pow(2, shift);
+                shift += 7;
+            } while (b & 0x80);
+            return (v % 2) ? -(v + 1) / 2 : v / 2;
+        };
+        if (content & 0x01) {
+            fields.push('ble');
+        }
+        if (content & 0x02) {
+            fields.push('both');
+        }
+        if (content & 0x04) {
+            fields.push('estimated');
+        }
+        decoded.seq = bytes[0];
+        fields.forEach(function (field) {
+            decoded[field] = [];
+            last[field] = 0;
+        });
+        for (var c = 0; c < bytes[2]; c++) {
+            fields.forEach(function (field) {
+                if (field === 'estimated') {
+                    decoded.estimated.push(bytes[pos++]);
+                } else if (content & 0x08) {
+                    decoded[field].push(uint16(bytes.slice(pos, pos += 2)));
+                } else {
+                    last[field] += varint();
+                    decoded[field].push(last[field]);
+                }
+            });
+        }
+        return decoded;
+    }
+
+    if (port === 19) {
+        // records of a send cycle, each tagged with its port and length
+        for (var j = 0; j + 2 <= bytes.length; j += 2 + bytes[j + 1]) {
+            var record = Decoder(bytes.slice(j + 2, j + 2 + bytes[j + 1]), bytes[j]);
+            for (var field in record) {
+                decoded[field] = record[field];
+            }
+        }
+        return decoded;
+    }
+
 }
 
 
@@ -101,6 +230,17 @@ var uint16 = function (bytes) {
 };
 uint16.BYTES = 2;
 
+// signed values, e.g. RSSI, not part of lora-serialization
+var int8 = function (bytes) {
+    return (uint8(bytes) << 24) >> 24;
+};
+int8.BYTES = 1;
+
+var int16 = function (bytes) {
+    return (uint16(bytes) << 16) >> 16;
+};
+int16.BYTES = 2;
+
 var uint32 = function (bytes) {
     if (bytes.length !== uint32.BYTES) {
         throw new Error('uint32 must have exactly 4 bytes');
@@ -233,6 +373,8 @@ if (typeof module === 'object' && typeof module.exports !== 'undefined') {
         uint8: uint8,
         uint16: uint16,
         uint32: uint32,
+        int8: int8,
+        int16: int16,
         uptime: uptime,
         float: float,
         ufloat: ufloat,
@@ -6,14 +6,28 @@ function Decoder(bytes, port) {
 
   if (port === 1) {
     var i = 0;
+    // counts are followed by 13 bytes gps data, if present, and a flags
+    // byte, if counts are estimated
+    var length = bytes.length;
+    if ([3, 5, 7, 16, 18, 20].indexOf(length) >= 0) {
+      decoded.estimated = bytes[--length];
+    }
+    var counts = length > 13 ? length - 13 : length;
 
-    if (bytes.length >= 2) {
+    if (counts >= 2) {
     decoded.wifi = (bytes[i++] << 8) | bytes[i++];}
     
-    if (bytes.length >= 4) {
+    if (counts >= 4) {
     decoded.ble = (bytes[i++] << 8) | bytes[i++];}
 
-    if (bytes.length > 4) {
+    if (counts >= 6) {
+      decoded.both = (bytes[i++] << 8) | bytes[i++];
+      decoded.wifionly = decoded.wifi - decoded.both;
+      decoded.bleonly = decoded.ble - decoded.both;
+      decoded.pax = decoded.wifi + decoded.ble - decoded.both;
+    }
+
+    if (length > counts) {
       decoded.latitude = ((bytes[i++] << 24) | (bytes[i++] << 16) | (bytes[i++] << 8) | bytes[i++]);
       decoded.longitude = ((bytes[i++] << 24) | (bytes[i++] << 16) | (bytes[i++] << 8) | bytes[i++]);
       decoded.sats = bytes[i++];
@@ -33,6 +47,27 @@ function Decoder(bytes, port) {
     decoded.reset1 = bytes[i++];
   }
 
+  if (port === 3) {
+    var i = 0;
+    decoded.lorasf = bytes[i++];
+    decoded.txpower = bytes[i++];
+    decoded.adrmode = bytes[i++];
+    decoded.screensaver = bytes[i++];
+    decoded.screenon = bytes[i++];
+    decoded.countermode = bytes[i++];
+    decoded.rssilimit = ((bytes[i++] << 24) | (bytes[i++] << 16)) >> 16;
+    decoded.sendcycle = bytes[i++];
+    decoded.wifichancycle = bytes[i++];
+    decoded.blescantime = bytes[i++];
+    decoded.blescan = bytes[i++];
+    decoded.wifiant = bytes[i++];
+    decoded.vendorfilter = bytes[i++];
+    decoded.rgblum = bytes[i++];
+    decoded.payloadmask = bytes[i++];
+    decoded.monitormode = bytes[i++];
+    decoded.version = String.fromCharCode.apply(null, bytes.slice(i, i + 10)).split('\u0000')[0];
+  }
+
   if (port === 4) {
     var i = 0;
     decoded.latitude = ((bytes[i++] << 24) | (bytes[i++] << 16) | (bytes[i++] << 8) | bytes[i++]);
@@ -49,8 +84,12 @@ function Decoder(bytes, port) {
 
   if (port === 6) {
     var i = 0;
-    decoded.rssi = bytes[i++];
+    decoded.rssi = (bytes[i++] << 24) >> 24; // signed
     decoded.beacon = bytes[i++];
+    // several beacon alarms in one message
+    decoded.alarms = [];
+    for (i = 0; i + 2 <= bytes.length; i += 2)
+      decoded.alarms.push({ rssi: (bytes[i] << 24) >> 24, beacon: bytes[i + 1] });
   }
   
   if (port === 7) {
@@ -61,6 +100,116 @@ function Decoder(bytes, port) {
     decoded.air = ((bytes[i++] << 8) | bytes[i++]);
   }
 
+  if (port === 8) {
+    decoded.voltage = (bytes[0] << 8) | bytes[1];
+  }
+
+  if (port === 9) {
+    var i = 0;
+    decoded.precision = bytes[i++];
+    decoded.offset = bytes[i++];
+    decoded.registers = bytes.slice(i);
+  }
+
+  if (port === 13) {
+    var i = 0;
+    while (i + 3 <= bytes.length) {
+      var minutes = bytes[i++];
+      decoded['pax' + minutes + 'min'] = (bytes[i++] << 8) | bytes[i++];
+    }
+  }
+
+  if (port === 14) {
+    var i = 0;
+    decoded.dwell = [];
+    while (i + 2 <= bytes.length)
+      decoded.dwell.push((bytes[i++] << 8) | bytes[i++]);
+  }
+
+  if (port === 15) {
+    var i = 0;
+    decoded.channels = [];
+    while (i + 3 <= bytes.length)
+      decoded.channels.push({
+        'yield': (bytes[i++] << 8) | bytes[i++],
+        'share': bytes[i++]
+      });
+  }
+
+  if (port === 16) {
+    // unique counts per RSSI band
+    decoded.near = (bytes[0] << 8) | bytes[1];
+    decoded.mid = (bytes[2] << 8) | bytes[3];
+    decoded.far = (bytes[4] << 8) | bytes[5];
+  }
+
+  if (port === 17) {
+    // new, returning and departed devices
+    decoded.new = (bytes[0] << 8) | bytes[1];
+    decoded.returning = (bytes[2] << 8) | bytes[3];
+    decoded.departed = (bytes[4] << 8) | bytes[5];
+  }
+
+  if (port === 18) {
+    // sniffer performance counters
+    var names = ['wififrames', 'bleadverts', 'rssidropped', 'vendordropped',
+      'ringdropped', 'collisions', 'insertns', 'batchmaxus'];
+    for (var k = 0; k < names.length; k++) {
+      decoded[names[k]] = (bytes[2 * k] << 8) | bytes[2 * k + 1];
+    }
+  }
+
+  if (port === 20) {
+    // counts of send cycles kept while LoRa was busy: sequence number of
+    // first cycle, content bits, number of cycles, then per cycle counts,
+    // raw or as deltas to predecessor in zigzag LEB128 varints, and flags
+    var pos = 3, content = bytes[1];
+    var fields = ['wifi'], last = {};
+    var varint = function () {
+      var v = 0, shift = 0, b;
+      do {
+        b = bytes[pos++];
+        v += (b & 0x7F) * Math.pow(2, shift);
+        shift += 7;
+      } while (b & 0x80);
+      return (v % 2) ? -(v + 1) / 2 : v / 2;
+    };
+    if (content & 0x01)
+      fields.push('ble');
+    if (content & 0x02)
+      fields.push('both');
+    if (content & 0x04)
+      fields.push('estimated');
+    decoded.seq = bytes[0];
+    for (var f = 0; f < fields.length; f++) {
+      decoded[fields[f]] = [];
+      last[fields[f]] = 0;
+    }
+    for (var c = 0; c < bytes[2]; c++) {
+      for (f = 0; f < fields.length; f++) {
+        if (fields[f] === 'estimated') {
+          decoded.estimated.push(bytes[pos++]);
+        } else if (content & 0x08) {
+          decoded[fields[f]].push(bytes[pos] | (bytes[pos + 1] << 8));
+          pos += 2;
+        } else {
+          last[fields[f]] += varint();
+          decoded[fields[f]].push(last[fields[f]]);
+        }
+      }
+    }
+  }
+
+  if (port === 19) {
+    // records of a send cycle, each tagged with its port and length
+    for (var j = 0; j + 2 <= bytes.length; j += 2 + bytes[j + 1]) {
+      var record = Decoder(bytes.slice(j + 2, j + 2 + bytes[j + 1]), bytes[j]);
+      for (var field in record) {
+        decoded[field] = record[field];
+      }
+    }
+  }
+
   return decoded;
 
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+// Round trip test of the payload decoders: decodes payloads written by the
+// device's encoders with the decoder of their payload format and compares
+// the result with the values encoded. Test vectors are written by unit test
+// test_decoders of the native build (see test/), one per line:
+// {"format": 1..4, "port": n, "bytes": [...], "expect": {field: value, ...}}
+// usage: node src/TTN/test_decoders.js vectors.json
+
+var fs = require('fs');
+var vm = require('vm');
+var path = require('path');
+
+// decoders are scripts for TTN console, not node modules
+function load(file) {
+    var context = {};
+    vm.runInNewContext(fs.readFileSync(path.join(__dirname, file), 'utf8'), context);
+    return context.Decoder;
+}
+
+// Cayenne LPP as decoded by TTN console, formats 3 (with channels) and 4
+// (without channels, values of a type are numbered in order of appearance)
+var lppTypes = {
+    0: { name: 'digital_in', size: 1, scale: 1, signed: false },
+    2: { name: 'analog_in', size: 2, scale: 100, signed: true },
+    101: { name: 'luminosity', size: 2, scale: 1, signed: false },
+    102: { name: 'presence', size: 1, scale: 1, signed: false },
+    103: { name: 'temperature', size: 2, scale: 10, signed: true },
+    104: { name: 'relative_humidity', size: 1, scale: 2, signed: false },
+    115: { name: 'barometric_pressure', size: 2, scale: 10, signed: false },
+    136: { name: 'gps', size: 9 }
+};
+
+function lppValue(bytes, pos, size, scale, signed) {
+    var v = 0;
+    for (var i = 0; i < size; i++) {
+        v = v * 256 + bytes[pos + i];
+    }
+    if (signed && v >= Math.pow(2, 8 * size - 1)) {
+        v -= Math.pow(2, 8 * size);
+    }
+    return v / scale;
+}
+
+function lppDecoder(channels) {
+    return function (bytes, port) {
+        var decoded = {}, seen = {}, pos = 0;
+        while (pos < bytes.length) {
+            var channel = channels ? bytes[pos++] : null;
+            var type = lppTypes[bytes[pos++]];
+            if (!type || pos + type.size > bytes.length) {
+                throw new Error('bad Cayenne LPP type or length at byte ' + pos);
+            }
+            if (!channels) {
+                channel = seen[type.name] = (seen[type.name] || 0) + 1;
+                channel--;
+            }
+            decoded[type.name + '_' + channel] = type.name === 'gps' ? {
+                latitude: lppValue(bytes, pos, 3, 10000, true),
+                longitude: lppValue(bytes, pos + 3, 3, 10000, true),
+                altitude: lppValue(bytes, pos + 6, 3, 100, true)
+            } : lppValue(bytes, pos, type.size, type.scale, type.signed);
+            pos += type.size;
+        }
+        return decoded;
+    };
+}
+
+var decoders = {
+    1: load('plain_decoder.js'),
+    2: load('packed_decoder.js'),
+    3: lppDecoder(true),
+    4: lppDecoder(false)
+};
+
+// expected fields must be present with equal values, others are ignored;
+// numbers may differ by rounding of the decoder
+function mismatch(expect, actual, field) {
+    if (typeof expect === 'object' && expect !== null) {
+        if (typeof actual !== 'object' || actual === null) {
+            return field + ': expected ' + JSON.stringify(expect) + ', got ' + JSON.stringify(actual);
+        }
+        for (var key in expect) {
+            var m = mismatch(expect[key], actual[key], field + '.' + key);
+            if (m) {
+                return m;
+            }
+        }
+        return null;
+    }
+    if (typeof expect === 'number' && typeof actual === 'number' &&
+        Math.abs(expect - actual) <= 1e-6 * Math.max(1, Math.abs(expect))) {
+        return null;
+    }
+    return expect === actual ? null :
+        field + ': expected ' + JSON.stringify(expect) + ', got ' + JSON.stringify(actual);
+}
+
+var failed = 0, passed = 0;
+fs.readFileSync(process.argv[2], 'utf8').split('\n').forEach(function (line) {
+    if (!line.trim()) {
+        return;
+    }
+    var vector = JSON.parse(line), m;
+    try {
+        m = mismatch(vector.expect, decoders[vector.format](vector.bytes, vector.port), 'decoded');
+    } catch (e) {
+        m = e.message;
+    }
+    if (m) {
+        failed++;
+        console.log('format ' + vector.format + ' port ' + vector.port + ' [' + vector.bytes + ']: ' + m);
+    } else {
+        passed++;
+    }
+});
+console.log(passed + ' payloads decoded as encoded, ' + failed + ' failed');
+process.exit(failed ? 1 : 0);
@@ -0,0 +1,134 @@
+#include "beaconregistry.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// slots must be a power of 2, the table takes up to 3/4 of them
+BeaconRegistry::BeaconRegistry(uint16_t n, uint32_t h)
+    : size(n), count(0), holdoff(h) {
+  slots = (Beacon_t *)malloc(size * sizeof(Beacon_t));
+  clear();
+}
+
+BeaconRegistry::~BeaconRegistry(void) { free(slots); }
+
+void BeaconRegistry::clear(void) {
+  if (slots)
+    memset(slots, 0, size * sizeof(Beacon_t));
+  count = 0;
+}
+
+uint8_t BeaconRegistry::getCount(void) const { return count; }
+
+// fold 48bit MAC to 32bit and scramble by Fibonacci hashing
+uint16_t BeaconRegistry::slot(uint64_t mac) const {
+  const uint32_t h = ((uint32_t)mac ^ (uint32_t)(mac >> 32)) * 0x9E3779B1UL;
+  return (h >> 16) & (size - 1);
+}
+
+int16_t BeaconRegistry::find(uint64_t mac) const {
+  uint16_t idx = slot(mac);
+  while (slots[idx].mac) {
+    if (slots[idx].mac == mac)
+      return idx;
+    idx = (idx + 1) & (size - 1);
+  }
+  return -1;
+}
+
+// delete entry by shifting back following entries of its probe sequence,
+// so no tombstones are needed
+void BeaconRegistry::remove(uint16_t idx) {
+  uint16_t next = idx, home;
+  slots[idx].mac = 0;
+  count--;
+  for (;;) {
+    next = (next + 1) & (size - 1);
+    if (!slots[next].mac)
+      return;
+    home = slot(slots[next].mac);
+    // entry can move to hole if its home is not cyclically in (idx, next]
+    if (((next - home) & (size - 1)) >= ((next - idx) & (size - 1))) {
+      slots[idx] = slots[next];
+      slots[next].mac = 0;
+      idx = next;
+    }
+  }
+}
+
+// assign MAC to beacon id, MAC 0 removes beacon id from registry
+bool BeaconRegistry::set(uint8_t id, uint64_t mac) {
+  int16_t idx;
+
+  if (!slots || id > BEACON_ID_MAX)
+    return false;
+
+  // an id stands for one MAC, so remove previous MAC of this id
+  for (uint16_t i = 0; i < size; i++)
+    if (slots[i].mac && slots[i].id == id) {
+      remove(i);
+      break;
+    }
+
+  if (!mac)
+    return true;
+
+  idx = find(mac);
+  if (idx < 0) {
+    if (count >= size - size / 4)
+      return false; // table full
+    idx = slot(mac);
+    while (slots[idx].mac)
+      idx = (idx + 1) & (size - 1);
+    memset(&slots[idx], 0, sizeof(Beacon_t));
+    slots[idx].mac = mac;
+    count++;
+  }
+  slots[idx].id = id;
+  return true;
+}
+
+// register a sighting, returns BEACON_ALARM if it raised a new alarm
+uint8_t BeaconRegistry::seen(uint64_t mac, int8_t rssi, uint32_t now,
+                             uint8_t *id) {
+  if (!slots || !count)
+    return BEACON_UNKNOWN;
+
+  const int16_t idx = find(mac);
+  if (idx < 0)
+    return BEACON_UNKNOWN;
+
+  Beacon_t *b = &slots[idx];
+  *id = b->id;
+
+  // exponential moving average of RSSI, first sighting sets start value
+  if (b->flags & BEACON_SEEN)
+    b->rssi += (rssi * 16 - b->rssi) >> BEACON_RSSI_SHIFT;
+  else
+    b->rssi = rssi * 16;
+  b->flags |= BEACON_SEEN;
+  b->lastseen = now;
+
+  if ((b->flags & BEACON_PENDING) ||
+      ((b->flags & BEACON_ALARMED) && (now - b->lastalarm < holdoff)))
+    return BEACON_KNOWN;
+
+  b->flags |= BEACON_PENDING | BEACON_ALARMED;
+  b->lastalarm = now;
+  return BEACON_ALARM;
+}
+
+// take up to max pending alarms, with smoothed RSSI, returns number taken
+uint8_t BeaconRegistry::collectAlarms(int8_t rssi[], uint8_t ids[],
+                                      uint8_t max) {
+  uint8_t n = 0;
+  if (!slots)
+    return 0;
+  for (uint16_t i = 0; (i < size) && (n < max); i++)
+    if (slots[i].mac && (slots[i].flags & BEACON_PENDING)) {
+      slots[i].flags &= ~BEACON_PENDING;
+      rssi[n] = slots[i].rssi / 16;
+      ids[n++] = slots[i].id;
+    }
+  return n;
+}
@@ -0,0 +1,128 @@
+#include "bleadv.h"
+#include "bleclass_array.h"
+
+#include <string.h>
+
+#define RULES_COUNT (sizeof(bleclass_rules) / sizeof(bleclass_rules[0]))
+
+void ble_ad_begin(BleAdIter_t *it, const uint8_t *data, uint8_t len) {
+  it->pos = data;
+  it->end = data + len;
+}
+
+// next AD structure, returns false at end of data
+bool ble_ad_next(BleAdIter_t *it, uint8_t *type, const uint8_t **data,
+                 uint8_t *len) {
+  if (it->pos + 2 > it->end)
+    return false;
+  const uint8_t size = it->pos[0]; // AD type and data
+  if (!size || (it->pos + 1 + size > it->end))
+    return false; // padding or truncated structure
+  *type = it->pos[1];
+  *data = it->pos + 2;
+  *len = size - 1;
+  it->pos += 1 + size;
+  return true;
+}
+
+void ble_adv_parse(const uint8_t *data, uint8_t len, BleAdv_t *adv) {
+  BleAdIter_t it;
+  const uint8_t *ad;
+  uint8_t type, size;
+
+  memset(adv, 0, sizeof(BleAdv_t));
+  ble_ad_begin(&it, data, len);
+
+  while (ble_ad_next(&it, &type, &ad, &size)) {
+    switch (type) {
+    case BLE_AD_FLAGS:
+      if (size >= 1) {
+        adv->flags = ad[0];
+        adv->fields |= BLE_HAS_FLAGS;
+      }
+      break;
+    case BLE_AD_UUID16_INCOMPLETE:
+    case BLE_AD_UUID16_COMPLETE:
+      if (size >= 2) {
+        adv->uuid16 = ad;
+        adv->uuid16_len = size & ~1;
+        adv->fields |= BLE_HAS_UUID16;
+      }
+      break;
+    case BLE_AD_TXPOWER:
+      if (size >= 1) {
+        adv->txpower = (int8_t)ad[0];
+        adv->fields |= BLE_HAS_TXPOWER;
+      }
+      break;
+    case BLE_AD_SVCDATA16:
+      if ((size >= 2) && !(adv->fields & BLE_HAS_SVCDATA)) {
+        adv->svcdata = ad[0] | (ad[1] << 8);
+        adv->fields |= BLE_HAS_SVCDATA;
+      }
+      break;
+    case BLE_AD_APPEARANCE:
+      if (size >= 2) {
+        adv->appearance = ad[0] | (ad[1] << 8);
+        adv->fields |= BLE_HAS_APPEARANCE;
+      }
+      break;
+    case BLE_AD_MANUFACTURER:
+      if (size >= 2) {
+        adv->company = ad[0] | (ad[1] << 8);
+        adv->mfdata = ad + 2;
+        adv->mfdata_len = size - 2;
+        adv->fields |= BLE_HAS_MANUFACTURER;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+static bool rule_matches(const BleAdv_t *adv, const BleRule_t *rule) {
+  uint32_t value;
+
+  switch (rule->field) {
+  case BLE_RULE_APPEARANCE:
+    if (!(adv->fields & BLE_HAS_APPEARANCE))
+      return false;
+    value = adv->appearance;
+    break;
+  case BLE_RULE_MANUFACTURER:
+    if (!(adv->fields & BLE_HAS_MANUFACTURER))
+      return false;
+    value = ((uint32_t)adv->company << 8) |
+            (adv->mfdata_len ? adv->mfdata[0] : 0);
+    break;
+  case BLE_RULE_UUID16:
+    if ((adv->fields & BLE_HAS_SVCDATA) &&
+        ((adv->svcdata & rule->mask) == rule->key))
+      return true;
+    for (uint8_t i = 0; i < adv->uuid16_len; i += 2)
+      if (((adv->uuid16[i] | (adv->uuid16[i + 1] << 8)) & rule->mask) ==
+          rule->key)
+        return true;
+    return false;
+  default:
+    return false;
+  }
+  return (value & rule->mask) == rule->key;
+}
+
+// class of first rule matching advertisement, BLE_CLASS_OTHER if none
+uint8_t ble_adv_classify(const BleAdv_t *adv, const BleRule_t rules[],
+                         uint8_t n) {
+  for (uint8_t i = 0; i < n; i++)
+    if (rule_matches(adv, &rules[i]))
+      return rules[i].cls;
+  return BLE_CLASS_OTHER;
+}
+
+// class of advertiser by rules of bleclass_array.h
+uint8_t ble_classify(const uint8_t *data, uint8_t len) {
+  BleAdv_t adv;
+  ble_adv_parse(data, len, &adv);
+  return ble_adv_classify(&adv, bleclass_rules, RULES_COUNT);
+}
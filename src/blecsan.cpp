@@ -3,6 +3,7 @@ https://github.com/nkolban/esp32-snippets/tree/master/BLE/scanner
 */
 
 #include "blescan.h"
+#include "macqueue.h"
 
 #define BT_BD_ADDR_HEX(addr)                                                   \
   addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]
@@ -10,6 +11,13 @@ https://github.com/nkolban/esp32-snippets/tree/master/BLE/scanner
 // local Tag for logging
 static const char TAG[] = "bluetooth";
 
+// advertisements of each class seen by callback since device start
+static uint32_t adv_stats[BLE_CLASSES] = {0};
+
+uint32_t ble_adverts(uint8_t cls) {
+  return cls < BLE_CLASSES ? adv_stats[cls] : 0;
+}
+
 const char *bt_addr_t_to_string(esp_ble_addr_type_t type) {
   switch (type) {
   case BLE_ADDR_TYPE_PUBLIC:
@@ -111,6 +119,7 @@ const char *btsig_gap_type(uint32_t gap_type) {
 IRAM_ATTR void gap_callback_handler(esp_gap_ble_cb_event_t event,
                                     esp_ble_gap_cb_param_t *param) {
   esp_ble_gap_cb_param_t *p = (esp_ble_gap_cb_param_t *)param;
+  uint8_t cls;
 
   ESP_LOGV(TAG, "BT payload rcvd -> type: 0x%.2x -> %s", *p->scan_rst.ble_adv,
            btsig_gap_type(*p->scan_rst.ble_adv));
@@ -133,6 +142,7 @@ IRAM_ATTR void gap_callback_handler(esp_gap_ble_cb_event_t event,
     if (p->scan_rst.search_evt ==
         ESP_GAP_SEARCH_INQ_RES_EVT) // Inquiry result for a peer device
     {                               // evaluate sniffed packet
+      perf_count(PERF_BLE_ADVERTS);
       ESP_LOGV(TAG, "Device address (bda): %02x:%02x:%02x:%02x:%02x:%02x",
                BT_BD_ADDR_HEX(p->scan_rst.bda));
       ESP_LOGV(TAG, "Addr_type           : %s",
@@ -141,6 +151,7 @@ IRAM_ATTR void gap_callback_handler(esp_gap_ble_cb_event_t event,
 
       if ((cfg.rssilimit) &&
           (p->scan_rst.rssi < cfg.rssilimit)) { // rssi is negative value
+        perf_count(PERF_BLE_RSSI_DROPPED);
         ESP_LOGI(TAG, "BLTH RSSI %d -> ignoring (limit: %d)", p->scan_rst.rssi,
                  cfg.rssilimit);
         break;
@@ -150,46 +161,26 @@ IRAM_ATTR void gap_callback_handler(esp_gap_ble_cb_event_t event,
 
       if ((p->scan_rst.ble_addr_type == BLE_ADDR_TYPE_RANDOM) ||
           (p->scan_rst.ble_addr_type == BLE_ADDR_TYPE_RPA_RANDOM)) {
+        perf_count(PERF_BLE_VENDOR_DROPPED);
         ESP_LOGV(TAG, "BT device filtered");
         break;
       }
 
 #endif
 
-      // add this device and show new count total if it was not previously added
-      mac_add((uint8_t *)p->scan_rst.bda, p->scan_rst.rssi, MAC_SNIFF_BLE);
-
-      /* to be improved in vendorfilter if:
-      
-
-      // you can search for elements in the payload using the
-      // function esp_ble_resolve_adv_data()
-      //
-      // Like this, that scans for the "Complete name" (looking inside the
-      payload buffer)
-      // uint8_t len;
-      // uint8_t *data = esp_ble_resolve_adv_data(p->scan_rst.ble_adv,
-      ESP_BLE_AD_TYPE_NAME_CMPL, &len);
-
-      filter BLE devices using their advertisements to get filter alternative to
-      vendor OUI if vendorfiltering is on, we ...
-      - want to count: mobile phones and tablets
-      - don't want to count: beacons, peripherals (earphones, headsets,
-      printers), cars and machines see
-      https://github.com/nkolban/ESP32_BLE_Arduino/blob/master/src/BLEAdvertisedDevice.cpp
-
-      http://www.libelium.com/products/meshlium/smartphone-detection/
-
-      https://www.question-defense.com/2013/01/12/bluetooth-cod-bluetooth-class-of-deviceclass-of-service-explained
-
-      https://www.bluetooth.com/specifications/assigned-numbers/baseband
-
-      "The Class of Device (CoD) in case of Bluetooth which allows us to
-      differentiate the type of device (smartphone, handsfree, computer,
-      LAN/network AP). With this parameter we can differentiate among
-      pedestrians and vehicles."
+      // classify advertiser by its advertising data, count selected classes
+      // only; rules see bleclass_array.h
+      cls = ble_classify(p->scan_rst.ble_adv,
+                         p->scan_rst.adv_data_len + p->scan_rst.scan_rsp_len);
+      adv_stats[cls]++;
+      if (!(cfg.bleclasses & (1 << cls))) {
+        ESP_LOGV(TAG, "BT device of class %d filtered", cls);
+        break;
+      }
 
-      */
+      // queue this device for counting
+      mac_enqueue(p->scan_rst.bda, p->scan_rst.rssi, p->scan_rst.ble_addr_type,
+                  MAC_SNIFF_BLE);
 
     } // evaluate sniffed packet
     break;
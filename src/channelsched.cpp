@@ -0,0 +1,75 @@
+#include "channelsched.h"
+
+#include <string.h>
+
+ChannelScheduler::ChannelScheduler(uint8_t f, uint8_t l, uint16_t r)
+    : first(f), last(l > CHANNEL_MAX ? CHANNEL_MAX : l), current(f),
+      revisit(r), tick(0) {
+  memset(stat, 0, sizeof(stat));
+}
+
+uint8_t ChannelScheduler::getChannel(void) const { return current; }
+
+uint32_t ChannelScheduler::getYield(uint8_t ch) const {
+  return (ch <= CHANNEL_MAX) ? stat[ch].yield : 0;
+}
+
+uint16_t ChannelScheduler::getSlots(uint8_t ch) const {
+  return (ch <= CHANNEL_MAX) ? stat[ch].slots : 0;
+}
+
+void ChannelScheduler::resetStats(void) {
+  for (uint8_t ch = first; ch <= last; ch++)
+    stat[ch].slots = 0;
+}
+
+void ChannelScheduler::setRevisit(uint16_t r) { revisit = r; }
+
+// count a new device seen on channel
+void ChannelScheduler::hit(uint8_t ch) {
+  if ((ch >= first) && (ch <= last) && (stat[ch].hits < 0xFFFF))
+    stat[ch].hits++;
+}
+
+// end of slot, returns channel to listen to in next slot
+uint8_t ChannelScheduler::next(void) {
+  ChannelStat_t *s = &stat[current];
+  uint8_t pick = 0, best = first;
+  uint32_t wait, maxwait = 0;
+  int32_t weight, total = 0;
+
+  // fold new devices of the slot into yield of the channel just listened to;
+  // devices of other channels, e.g. processed late, wait for their next slot
+  s->yield += ((int32_t)s->hits * CHANNEL_YIELD_ONE - s->yield) >>
+              CHANNEL_YIELD_SHIFT;
+  s->hits = 0;
+  if (s->slots < 0xFFFF)
+    s->slots++;
+  s->lastvisit = ++tick;
+
+  if (!revisit) {
+    current = (current < last) ? current + 1 : first;
+    return current;
+  }
+
+  for (uint8_t ch = first; ch <= last; ch++) {
+    // longest overdue channel goes first
+    wait = tick - stat[ch].lastvisit;
+    if ((wait >= revisit) && (wait > maxwait)) {
+      maxwait = wait;
+      pick = ch;
+    }
+    // smooth weighted round robin: credit all channels, largest account wins
+    weight = stat[ch].yield + CHANNEL_WEIGHT_MIN;
+    stat[ch].credit += weight;
+    total += weight;
+    if (stat[ch].credit > stat[best].credit)
+      best = ch;
+  }
+
+  if (!pick)
+    pick = best;
+  stat[pick].credit -= total;
+  current = pick;
+  return current;
+}
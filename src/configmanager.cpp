@@ -1,6 +1,7 @@
 /* configmanager persists runtime configuration using NVRAM of ESP32*/
 
 #include "globals.h"
+#include "wifiscan.h"
 #include <nvs.h>
 #include <nvs_flash.h>
 
@@ -17,7 +18,8 @@ void defaultConfig() {
   cfg.adrmode = 1;            // 0=disabled, 1=enabled
   cfg.screensaver = 0;        // 0=disabled, 1=enabled
   cfg.screenon = 1;           // 0=disabled, 1=enabled
-  cfg.countermode = 0;        // 0=cyclic, 1=cumulative, 2=cyclic confirmed
+  cfg.countermode = 0;        // 0=cyclic, 1=cumulative, 2=cyclic confirmed,
+                              // 3=cyclic with HyperLogLog sketch
   cfg.rssilimit = 0;          // threshold for rssilimiter, negative value!
   cfg.sendcycle = SEND_SECS;  // payload send cycle [seconds/2]
   cfg.wifichancycle =
@@ -30,6 +32,15 @@ void defaultConfig() {
   cfg.vendorfilter = 1;       // 0=disabled, 1=enabled
   cfg.rgblum = RGBLUMINOSITY; // RGB Led luminosity (0..100%)
   cfg.monitormode = 0;        // 0=disabled, 1=enabled
+  cfg.wififilter = WIFI_FILTER_PROFILE; // 0=all, 1=clients, 2=probe requests
+  cfg.bleclasses = BLE_CLASS_MASK;      // bit set of BLE advertiser classes
+#ifdef COUNT_BANDS
+  const int8_t bands[] = {COUNT_BANDS}; // lower edges of near and mid band
+  static_assert(sizeof(bands) == sizeof(cfg.rssiband),
+                "COUNT_BANDS needs edges of near and mid band");
+  memcpy(cfg.rssiband, bands, sizeof(cfg.rssiband));
+#endif
+  cfg.payloadformat = PAYLOAD_ENCODER; // 1=plain, 2=packed, 3/4=LPP
   cfg.runmode = 0;            // 0=normal, 1=update
   cfg.payloadmask = 0xFF;     // all payload switched on
   cfg.bsecstate[BSEC_MAX_STATE_BLOB_SIZE] = {
@@ -153,6 +164,26 @@ void saveConfig() {
         flash8 != cfg.monitormode)
       nvs_set_i8(my_handle, "monitormode", cfg.monitormode);
 
+    if (nvs_get_i8(my_handle, "wififilter", &flash8) != ESP_OK ||
+        flash8 != cfg.wififilter)
+      nvs_set_i8(my_handle, "wififilter", cfg.wififilter);
+
+    if (nvs_get_i8(my_handle, "bleclasses", &flash8) != ESP_OK ||
+        flash8 != cfg.bleclasses)
+      nvs_set_i8(my_handle, "bleclasses", cfg.bleclasses);
+
+    if (nvs_get_i8(my_handle, "bandnear", &flash8) != ESP_OK ||
+        flash8 != cfg.rssiband[0])
+      nvs_set_i8(my_handle, "bandnear", cfg.rssiband[0]);
+
+    if (nvs_get_i8(my_handle, "bandmid", &flash8) != ESP_OK ||
+        flash8 != cfg.rssiband[1])
+      nvs_set_i8(my_handle, "bandmid", cfg.rssiband[1]);
+
+    if (nvs_get_i8(my_handle, "payloadformat", &flash8) != ESP_OK ||
+        flash8 != cfg.payloadformat)
+      nvs_set_i8(my_handle, "payloadformat", cfg.payloadformat);
+
     if (nvs_get_i8(my_handle, "runmode", &flash8) != ESP_OK ||
         flash8 != cfg.runmode)
       nvs_set_i8(my_handle, "runmode", cfg.runmode);
@@ -347,6 +378,49 @@ void loadConfig() {
       saveConfig();
     }
 
+    if (nvs_get_i8(my_handle, "wififilter", &flash8) == ESP_OK &&
+        (uint8_t)flash8 <= WIFI_FILTER_PROBES) {
+      cfg.wififilter = flash8;
+      ESP_LOGI(TAG, "Wifi filter profile = %d", flash8);
+    } else {
+      ESP_LOGI(TAG, "Wifi filter profile set to default %d", cfg.wififilter);
+      saveConfig();
+    }
+
+    if (nvs_get_i8(my_handle, "bleclasses", &flash8) == ESP_OK &&
+        (uint8_t)flash8 <= BLE_CLASS_ALL) {
+      cfg.bleclasses = flash8;
+      ESP_LOGI(TAG, "BLE classes = 0x%02X", flash8);
+    } else {
+      ESP_LOGI(TAG, "BLE classes set to default 0x%02X", cfg.bleclasses);
+      saveConfig();
+    }
+
+    if (nvs_get_i8(my_handle, "bandnear", &flash8) == ESP_OK) {
+      cfg.rssiband[0] = flash8;
+      ESP_LOGI(TAG, "RSSI near band edge = %d", flash8);
+    } else {
+      ESP_LOGI(TAG, "RSSI near band edge set to default %d", cfg.rssiband[0]);
+      saveConfig();
+    }
+
+    if (nvs_get_i8(my_handle, "bandmid", &flash8) == ESP_OK) {
+      cfg.rssiband[1] = flash8;
+      ESP_LOGI(TAG, "RSSI mid band edge = %d", flash8);
+    } else {
+      ESP_LOGI(TAG, "RSSI mid band edge set to default %d", cfg.rssiband[1]);
+      saveConfig();
+    }
+
+    if (nvs_get_i8(my_handle, "payloadformat", &flash8) == ESP_OK &&
+        flash8 >= PAYLOAD_PLAIN && flash8 <= PAYLOAD_LPP_PACKED) {
+      cfg.payloadformat = flash8;
+      ESP_LOGI(TAG, "Payload format = %d", flash8);
+    } else {
+      ESP_LOGI(TAG, "Payload format set to default %d", cfg.payloadformat);
+      saveConfig();
+    }
+
     if (nvs_get_i8(my_handle, "runmode", &flash8) == ESP_OK) {
       cfg.runmode = flash8;
       ESP_LOGI(TAG, "Run mode = %d", flash8);
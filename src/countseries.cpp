@@ -0,0 +1,197 @@
+#include "countseries.h"
+#include "varint.h"
+
+#include <stdlib.h>
+
+CountSeries::CountSeries(uint16_t n)
+    : size(n), head(0), count(0), seq(0), lost(0) {
+  samples = (CountSample_t *)malloc(size * sizeof(CountSample_t));
+}
+
+CountSeries::~CountSeries(void) { free(samples); }
+
+void CountSeries::clear(void) {
+  seq += count;
+  head = 0;
+  count = 0;
+}
+
+uint16_t CountSeries::getCount(void) const { return count; }
+
+uint32_t CountSeries::getLost(void) const { return lost; }
+
+// append sample of a send cycle, overwrites oldest sample if full
+void CountSeries::add(const CountSample_t *sample) {
+  if (!samples)
+    return;
+  if (count == size) {
+    drop(1);
+    lost++;
+  }
+  samples[(head + count++) % size] = *sample;
+}
+
+// remove n oldest samples, after they were encoded and sent
+void CountSeries::drop(uint16_t n) {
+  if (n > count)
+    n = count;
+  head = (head + n) % size;
+  count -= n;
+  seq += n;
+}
+
+// counts of sample included by content, Wifi first; returns their number
+static uint8_t sample_counts(const CountSample_t *s, uint8_t content,
+                             uint16_t counts[3]) {
+  uint8_t k = 0;
+  counts[k++] = s->wifi;
+  if (content & COUNTSERIES_BLE)
+    counts[k++] = s->ble;
+  if (content & COUNTSERIES_BOTH)
+    counts[k++] = s->both;
+  return k;
+}
+
+// append sample as deltas to its predecessor or raw, if it fits, returns
+// its size anyway
+static size_t put_sample(uint8_t *buf, size_t pos, size_t len,
+                         uint8_t content, const CountSample_t *s,
+                         const CountSample_t *prev) {
+  uint16_t counts[3], prevs[3];
+  const uint8_t k = sample_counts(s, content, counts);
+  size_t n = 0;
+
+  sample_counts(prev, content, prevs);
+  for (uint8_t i = 0; i < k; i++) {
+    if (content & COUNTSERIES_RAW) {
+      if (pos + n + 2 <= len) {
+        buf[pos + n] = counts[i];
+        buf[pos + n + 1] = counts[i] >> 8;
+      }
+      n += 2;
+    } else
+      n += put_varint(buf, pos + n, len,
+                      zigzag((int32_t)counts[i] - prevs[i]));
+  }
+  if (content & COUNTSERIES_FLAGS) {
+    if (pos + n < len)
+      buf[pos + n] = s->flags;
+    n++;
+  }
+  return n;
+}
+
+// write up to max oldest samples behind header, as many as fit into len
+// bytes; returns number of samples and bytes written in *n
+uint8_t CountSeries::putRun(uint8_t *buf, uint8_t len, uint8_t content,
+                            uint16_t max, size_t *n) const {
+  const CountSample_t *prev = NULL;
+  const CountSample_t base = {0, 0, 0, 0};
+  uint8_t run = 0;
+  size_t k;
+
+  *n = COUNTSERIES_HEADER;
+  while (run < max) {
+    const CountSample_t *s = &samples[(head + run) % size];
+    // first sample is base, following ones are deltas to predecessor
+    k = put_sample(buf, *n, len, content, s, prev ? prev : &base);
+    if (*n + k > len)
+      break;
+    *n += k;
+    prev = s;
+    run++;
+  }
+  return run;
+}
+
+// encode a run of oldest samples, as many as fit into len bytes, without
+// removing them; returns bytes written and number of samples in *taken.
+// content selects BLE and both counts; flags are added if a sample has
+// some, counts are written raw if deltas would take more bytes
+uint8_t CountSeries::encode(uint8_t *buf, uint8_t len, uint8_t content,
+                            uint8_t *taken) const {
+  const uint16_t max = count < COUNTSERIES_RUN ? count : COUNTSERIES_RUN;
+  size_t n;
+
+  *taken = 0;
+  if (!count || len < COUNTSERIES_HEADER)
+    return 0;
+
+  content &= COUNTSERIES_BLE | COUNTSERIES_BOTH;
+  for (uint16_t i = 0; i < max; i++)
+    if (samples[(head + i) % size].flags) {
+      content |= COUNTSERIES_FLAGS;
+      break;
+    }
+
+  uint8_t run = putRun(buf, len, content, max, &n);
+  // raw samples have fixed size, take them if more fit or they are shorter
+  const size_t rawsize =
+      put_sample(buf, 0, 0, content | COUNTSERIES_RAW, samples, samples);
+  uint16_t rawrun = (len - COUNTSERIES_HEADER) / rawsize;
+  if (rawrun > max)
+    rawrun = max;
+  if (rawrun > run ||
+      (rawrun == run && COUNTSERIES_HEADER + rawrun * rawsize < n)) {
+    content |= COUNTSERIES_RAW;
+    run = putRun(buf, len, content, rawrun, &n);
+  }
+  if (!run)
+    return 0;
+
+  buf[0] = seq;
+  buf[1] = content;
+  buf[2] = run;
+  *taken = run;
+  return n;
+}
+
+// decode a run as written by encode(), returns number of samples, 0 if
+// invalid or more than max; counts not included are 0
+uint8_t CountSeries::decode(const uint8_t *buf, uint8_t len, uint8_t *seq,
+                            CountSample_t samples[], uint8_t max) {
+  size_t n = COUNTSERIES_HEADER, k;
+  uint32_t value;
+  int32_t counts[3] = {0, 0, 0};
+
+  if (len < COUNTSERIES_HEADER)
+    return 0;
+  const uint8_t content = buf[1], run = buf[2];
+  const uint8_t fields = 1 + ((content & COUNTSERIES_BLE) ? 1 : 0) +
+                         ((content & COUNTSERIES_BOTH) ? 1 : 0);
+  if (run > max || (content & ~(COUNTSERIES_BLE | COUNTSERIES_BOTH |
+                                COUNTSERIES_FLAGS | COUNTSERIES_RAW)))
+    return 0;
+
+  for (uint8_t i = 0; i < run; i++) {
+    for (uint8_t f = 0; f < fields; f++) {
+      if (content & COUNTSERIES_RAW) {
+        if (n + 2 > len)
+          return 0;
+        counts[f] = buf[n] | buf[n + 1] << 8;
+        n += 2;
+        continue;
+      }
+      if (!(k = get_varint(buf, n, len, &value)))
+        return 0;
+      n += k;
+      counts[f] += unzigzag(value);
+      if (counts[f] < 0 || counts[f] > 0xFFFF)
+        return 0;
+    }
+    uint8_t f = 0;
+    samples[i].wifi = counts[f++];
+    samples[i].ble = (content & COUNTSERIES_BLE) ? counts[f++] : 0;
+    samples[i].both = (content & COUNTSERIES_BOTH) ? counts[f++] : 0;
+    samples[i].flags = 0;
+    if (content & COUNTSERIES_FLAGS) {
+      if (n >= len)
+        return 0;
+      samples[i].flags = buf[n++];
+    }
+  }
+  if (n != len)
+    return 0;
+  *seq = buf[0];
+  return run;
+}
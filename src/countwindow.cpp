@@ -0,0 +1,61 @@
+#include "countwindow.h"
+
+#include <string.h>
+
+CountWindow::CountWindow() : stamps(NULL) {}
+
+// arena must hold COUNTWINDOW_SIZE bytes
+void CountWindow::begin(uint8_t *arena) {
+  stamps = arena;
+  clear();
+}
+
+bool CountWindow::isActive(void) const { return stamps != NULL; }
+
+void CountWindow::clear(void) {
+  if (stamps)
+    memset(stamps, COUNTWINDOW_EMPTY, COUNTWINDOW_SIZE);
+}
+
+void CountWindow::add(uint16_t hash, uint32_t minute) {
+  if (stamps)
+    stamps[hash] = minute % COUNTWINDOW_TICKS;
+}
+
+// counts[i] = number of hashes seen within the last windows[i] minutes,
+// evaluated in one pass over all stamps; stamps older than the largest
+// window are expired on the way; not reentrant
+void CountWindow::count(uint32_t minute, const uint8_t windows[],
+                        uint16_t counts[], uint8_t n) {
+  // histogram of stamp ages, too large for the caller's stack
+  static uint16_t ages[COUNTWINDOW_MAX];
+  uint8_t maxwindow = 0, age;
+  const uint8_t tick = minute % COUNTWINDOW_TICKS;
+
+  for (uint8_t i = 0; i < n; i++)
+    if (windows[i] > maxwindow)
+      maxwindow = windows[i];
+  if (maxwindow > COUNTWINDOW_MAX)
+    maxwindow = COUNTWINDOW_MAX;
+  memset(ages, 0, sizeof(ages));
+
+  if (stamps) {
+    for (uint32_t h = 0; h < COUNTWINDOW_SIZE; h++) {
+      if (stamps[h] == COUNTWINDOW_EMPTY)
+        continue;
+      age = (tick + COUNTWINDOW_TICKS - stamps[h]) % COUNTWINDOW_TICKS;
+      if (age < maxwindow) {
+        if (ages[age] < 0xFFFF) // all hashes may share one age
+          ages[age]++;
+      } else
+        stamps[h] = COUNTWINDOW_EMPTY; // expired
+    }
+  }
+
+  for (uint8_t i = 0; i < n; i++) {
+    uint32_t sum = 0;
+    for (uint8_t a = 0; (a < windows[i]) && (a < maxwindow); a++)
+      sum += ages[a];
+    counts[i] = sum > 0xFFFF ? 0xFFFF : sum;
+  }
+}
@@ -0,0 +1,138 @@
+#include "crossdedup.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// slots must be a power of 2, the table takes up to 3/4 of them
+CrossDedup::CrossDedup(uint16_t n, uint32_t w, uint8_t r)
+    : size(n), window(w), rssidiff(r) {
+  slots = (uint32_t *)malloc(size * sizeof(uint32_t));
+  clear();
+}
+
+CrossDedup::~CrossDedup(void) { free(slots); }
+
+void CrossDedup::clear(void) {
+  if (slots)
+    memset(slots, 0, size * sizeof(uint32_t));
+  memset(recent, 0, sizeof(recent));
+  head[CROSS_WIFI] = head[CROSS_BLE] = 0;
+  count = both = linked = 0;
+}
+
+// devices counted on Wifi and BLE, by address or co-occurrence
+uint16_t CrossDedup::getBoth(void) const { return both; }
+
+// of these, devices paired by address
+uint16_t CrossDedup::getLinked(void) const { return linked; }
+
+// salted key of address with NIC moved by delta, technology in bit 0; the
+// low bits are not part of the hash, so keys never collide across
+// technologies and never are 0 (empty slot)
+uint32_t CrossDedup::key(const uint8_t *mac, int8_t delta, uint8_t tech,
+                         uint32_t salt) const {
+  const uint32_t nic = ((mac[3] << 16) | (mac[4] << 8) | mac[5]) + delta;
+  uint64_t x = ((uint64_t)mac[0] << 40) | ((uint64_t)mac[1] << 32) |
+               ((uint64_t)mac[2] << 24) | (nic & 0xFFFFFF);
+  x = (x ^ ((uint64_t)salt << 16)) * 0x9E3779B97F4A7C15ULL;
+  const uint32_t h = (uint32_t)(x >> 32) & ~(uint32_t)0x03;
+  return (h ? h : 0x04) | tech;
+}
+
+int16_t CrossDedup::find(uint32_t k) const {
+  uint16_t idx = (k >> 16) & (size - 1);
+  while (slots[idx]) {
+    if ((slots[idx] & ~(uint32_t)CROSS_PAIRED) == k)
+      return idx;
+    idx = (idx + 1) & (size - 1);
+  }
+  return -1;
+}
+
+int16_t CrossDedup::insert(uint32_t k) {
+  if (count >= size - size / 4)
+    return -1; // table full, device can still pair by co-occurrence
+  uint16_t idx = (k >> 16) & (size - 1);
+  while (slots[idx])
+    idx = (idx + 1) & (size - 1);
+  slots[idx] = k;
+  count++;
+  return idx;
+}
+
+// take arrival of device in slot out of co-occurrence candidates
+void CrossDedup::take(uint8_t tech, int16_t slot) {
+  for (uint8_t i = 0; i < CROSS_RECENT; i++)
+    if (recent[tech][i].slot == slot)
+      recent[tech][i].flags |= CROSS_TAKEN;
+}
+
+// pair with the only recent unpaired arrival of other technology matching
+// in time and RSSI, if there is exactly one
+bool CrossDedup::cooccur(uint8_t tech, int8_t rssi, uint32_t now,
+                         int16_t slot) {
+  CrossArrival_t *match = NULL, *a = recent[tech ^ 1];
+  uint8_t candidates = 0, inwindow = 0;
+
+  for (uint8_t i = 0; i < CROSS_RECENT; i++, a++) {
+    if (!(a->flags & CROSS_USED) || (now - a->time > window))
+      continue;
+    inwindow++;
+    // two public addresses of one device are expected to be linked by
+    // address, so they are no candidates
+    if (!(a->flags & CROSS_TAKEN) && ((slot < 0) || (a->slot < 0)) &&
+        (abs(rssi - a->rssi) <= rssidiff)) {
+      candidates++;
+      match = a;
+    }
+  }
+
+  // all recent arrivals within window means there may be more, ambiguous
+  if ((candidates == 1) && (inwindow < CROSS_RECENT)) {
+    match->flags |= CROSS_TAKEN;
+    if (match->slot >= 0)
+      slots[match->slot] |= CROSS_PAIRED;
+    if (slot >= 0)
+      slots[slot] |= CROSS_PAIRED;
+    both++;
+    return true;
+  }
+
+  // remember arrival for devices of other technology still to come
+  a = &recent[tech][head[tech]];
+  head[tech] = (head[tech] + 1) % CROSS_RECENT;
+  a->time = now;
+  a->slot = slot;
+  a->rssi = rssi;
+  a->flags = CROSS_USED;
+  return false;
+}
+
+// register device newly counted on technology tech, linkable if mac is a
+// public (globally unique) address; returns true if device was paired with
+// a device of the other technology
+bool CrossDedup::add(const uint8_t *mac, uint8_t tech, bool linkable,
+                     int8_t rssi, uint32_t now, uint32_t salt) {
+  int16_t slot = -1;
+
+  if (!slots)
+    return false;
+
+  if (linkable) {
+    for (int8_t d = -CROSS_NIC_SPAN; d <= CROSS_NIC_SPAN; d++) {
+      // address of other technology, NIC moved by d
+      const int16_t other = find(key(mac, d, tech ^ 1, salt));
+      if ((other >= 0) && !(slots[other] & CROSS_PAIRED)) {
+        slots[other] |= CROSS_PAIRED;
+        take(tech ^ 1, other);
+        insert(key(mac, 0, tech, salt) | CROSS_PAIRED);
+        both++;
+        linked++;
+        return true;
+      }
+    }
+    slot = insert(key(mac, 0, tech, salt));
+  }
+
+  return cooccur(tech, rssi, now, slot);
+}
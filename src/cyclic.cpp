@@ -41,6 +41,52 @@ void doHousekeeping() {
   ESP_LOGD(TAG, "IRQhandler %d bytes left | Taskstate = %d",
            uxTaskGetStackHighWaterMark(irqHandlerTask),
            eTaskGetState(irqHandlerTask));
+  ESP_LOGD(TAG, "Macloop %d bytes left | Taskstate = %d",
+           uxTaskGetStackHighWaterMark(macLoopTask),
+           eTaskGetState(macLoopTask));
+
+  // sniffer rates since last housekeeping
+  perf_update();
+
+  // send buffer statistics
+  ESP_LOGI(TAG, "Send buffers: %d exhausted, %d/%d max. used",
+           sendpool.getExhausted(), sendpool.getHighwater(),
+           sendpool.capacity());
+
+#ifdef HAS_LORA
+  // LoRa send queue statistics per class
+  static const char *classes[SEND_CLASSES] = {"alarms", "replies", "counts",
+                                              "telemetry"};
+  for (uint8_t c = 0; c < SEND_CLASSES; c++) {
+    const SendStats_t *stats = lora_sendstats(c);
+    ESP_LOGI(TAG, "LoRa %s: %d queued, %d superseded, %d dropped", classes[c],
+             stats->queued, stats->coalesced, stats->dropped);
+  }
+#endif
+
+  // MAC ring statistics
+  ESP_LOGI(TAG, "Wifi ring: %d dropped, %d/%d max. used",
+           mac_queue_dropped(MAC_SNIFF_WIFI),
+           mac_queue_highwater(MAC_SNIFF_WIFI), MAC_QUEUE_SIZE);
+  ESP_LOGD(TAG,
+           "Wifi frames: %d probe, %d assoc, %d to AP, %d other mgmt, "
+           "%d AP, %d other data, %d ctrl, %d group",
+           wifi_frames(WIFI_FRAME_PROBE), wifi_frames(WIFI_FRAME_ASSOC),
+           wifi_frames(WIFI_FRAME_TODS), wifi_frames(WIFI_FRAME_MGMT),
+           wifi_frames(WIFI_FRAME_AP), wifi_frames(WIFI_FRAME_DATA),
+           wifi_frames(WIFI_FRAME_CTRL), wifi_frames(WIFI_FRAME_GROUP));
+#ifdef PROBE_FINGERPRINT
+  ESP_LOGI(TAG, "Randomized MAC probes: %d, %d merged into clusters",
+           mac_queue_probes(), mac_queue_merged());
+#endif
+#ifdef BLECOUNTER
+  ESP_LOGI(TAG, "BLE ring: %d dropped, %d/%d max. used",
+           mac_queue_dropped(MAC_SNIFF_BLE), mac_queue_highwater(MAC_SNIFF_BLE),
+           MAC_QUEUE_SIZE);
+  ESP_LOGD(TAG, "BLE advertisers: %d phone, %d wearable, %d beacon, %d other",
+           ble_adverts(BLE_CLASS_PHONE), ble_adverts(BLE_CLASS_WEARABLE),
+           ble_adverts(BLE_CLASS_BEACON), ble_adverts(BLE_CLASS_OTHER));
+#endif
 #ifdef HAS_GPS
   ESP_LOGD(TAG, "Gpsloop %d bytes left | Taskstate = %d",
            uxTaskGetStackHighWaterMark(GpsTask), eTaskGetState(GpsTask));
@@ -68,31 +114,27 @@ void doHousekeeping() {
            bme_status.temperature, bme_status.iaq, bme_status.iaq_accuracy);
 #endif
 
-  // check free heap memory
-  if (ESP.getMinFreeHeap() <= MEM_LOW) {
-    ESP_LOGI(TAG,
-             "Memory full, counter cleared (heap low water mark = %d Bytes / "
-             "free heap = %d bytes)",
-             ESP.getMinFreeHeap(), ESP.getFreeHeap());
-    SendPayload(COUNTERPORT); // send data before clearing counters
-    reset_counters();         // clear macs container and reset all counters
-    get_salt();               // get new salt for salting hashes
+#ifdef SNAPSHOT_SIZE
+  // keep counts of this send cycle across watchdog or brownout resets
+  COUNT_MUTEX_LOCK();
+  snapshot_save(false);
+  COUNT_MUTEX_UNLOCK();
+#endif
 
-    if (ESP.getMinFreeHeap() <= MEM_LOW) // check again
-      do_reset();                        // memory leak, reset device
-  }
+  // check free heap memory; counting stores have fixed size and are
+  // allocated at startup, so there is nothing to clear, counts degrade to
+  // estimates instead, see MacBitmap::estimate()
+  if (ESP.getMinFreeHeap() <= MEM_LOW)
+    ESP_LOGW(TAG,
+             "Memory low (heap low water mark = %d Bytes / free heap = %d "
+             "bytes)",
+             ESP.getMinFreeHeap(), ESP.getFreeHeap());
 
 // check free PSRAM memory
 #ifdef BOARD_HAS_PSRAM
-  if (ESP.getMinFreePsram() <= MEM_LOW) {
-    ESP_LOGI(TAG, "PSRAM full, counter cleared");
-    SendPayload(COUNTERPORT); // send data before clearing counters
-    reset_counters();         // clear macs container and reset all counters
-    get_salt();               // get new salt for salting hashes
-
-    if (ESP.getMinFreePsram() <= MEM_LOW) // check again
-      do_reset();                         // memory leak, reset device
-  }
+  if (ESP.getMinFreePsram() <= MEM_LOW)
+    ESP_LOGW(TAG, "PSRAM low (low water mark = %d Bytes)",
+             ESP.getMinFreePsram());
 #endif
 
 } // doHousekeeping()
@@ -117,6 +159,14 @@ uint32_t getFreeRAM() {
 
 void reset_counters() {
   macs.clear();   // clear all macs container
+  blemacs.clear(); // clear BLE macs container
+#ifdef CROSS_DEDUP
+  crossdedup.clear(); // forget devices seen on both Wifi and BLE
+#endif
+#ifdef COUNT_BANDS
+  rssibands.clear(); // clear band of each mac
+#endif
+  sketch.clear(); // clear HyperLogLog registers
   macs_total = 0; // reset all counters
   macs_wifi = 0;
   macs_ble = 0;
@@ -147,10 +147,8 @@ void refreshtheDisplay() {
 #endif
 
     // update counter (lines 0-1)
-    snprintf(
-        buff, sizeof(buff), "PAX:%-4d",
-        (int)
-            macs.size()); // convert 16-bit MAC counter to decimal counter value
+    snprintf(buff, sizeof(buff), "PAX:%-4d",
+             (int)macs_total); // Wifi + BLE, devices seen on both count once
     u8x8.draw2x2String(0, 0,
                        buff); // display number on unique macs total Wifi + BLE
 
@@ -231,7 +229,7 @@ void refreshtheDisplay() {
     u8x8.printf("%-14s", display_line7);
 
     // update LoRa send queue display (line 7)
-    msgWaiting = uxQueueMessagesWaiting(LoraSendQueue);
+    msgWaiting = lora_queuewaiting();
     if (msgWaiting) {
       sprintf(buff, "%2d", msgWaiting);
       u8x8.setCursor(14, 7);
@@ -0,0 +1,131 @@
+#include "dwelltable.h"
+
+#include <string.h>
+
+DwellTable::DwellTable() : entries(NULL), buckets(NULL), size(0) {}
+
+// bytes needed for a table of given number of entries, which must be a
+// power of 2; buckets are as many as entries
+size_t DwellTable::arenaSize(uint16_t entries) {
+  return entries * (sizeof(DwellEntry_t) + sizeof(uint16_t));
+}
+
+void DwellTable::begin(void *arena, uint16_t n) {
+  entries = (DwellEntry_t *)arena;
+  buckets = (uint16_t *)(entries + n);
+  size = n;
+  clear();
+  resetHistogram();
+}
+
+bool DwellTable::isActive(void) const { return entries != NULL; }
+
+void DwellTable::clear(void) {
+  if (!entries)
+    return;
+  for (uint16_t i = 0; i < size; i++) {
+    buckets[i] = DWELL_NIL;
+    entries[i].next = (i + 1 < size) ? i + 1 : DWELL_NIL;
+  }
+  freelist = 0;
+  newest = oldest = DWELL_NIL;
+  used = 0;
+}
+
+const uint16_t *DwellTable::getHistogram(void) const { return histogram; }
+
+void DwellTable::resetHistogram(void) {
+  memset(histogram, 0, sizeof(histogram));
+}
+
+uint16_t DwellTable::getUsed(void) const { return used; }
+
+void DwellTable::unlinkLRU(uint16_t idx) {
+  DwellEntry_t *e = &entries[idx];
+  if (e->older != DWELL_NIL)
+    entries[e->older].newer = e->newer;
+  else
+    oldest = e->newer;
+  if (e->newer != DWELL_NIL)
+    entries[e->newer].older = e->older;
+  else
+    newest = e->older;
+}
+
+void DwellTable::pushLRU(uint16_t idx) {
+  DwellEntry_t *e = &entries[idx];
+  e->older = newest;
+  e->newer = DWELL_NIL;
+  if (newest != DWELL_NIL)
+    entries[newest].newer = idx;
+  else
+    oldest = idx;
+  newest = idx;
+}
+
+void DwellTable::unlinkBucket(uint16_t idx) {
+  uint16_t *p = &buckets[entries[idx].hash & (size - 1)];
+  while (*p != idx)
+    p = &entries[*p].next;
+  *p = entries[idx].next;
+}
+
+// book dwell time of entry to histogram and return entry to free list
+void DwellTable::finish(uint16_t idx) {
+  DwellEntry_t *e = &entries[idx];
+  uint32_t minutes = (e->last - e->first) / 60;
+  uint8_t bin = 0;
+
+  while (minutes && (bin < DWELL_BINS - 1)) {
+    minutes >>= 1;
+    bin++;
+  }
+  if (histogram[bin] < 0xFFFF)
+    histogram[bin]++;
+
+  unlinkBucket(idx);
+  unlinkLRU(idx);
+  e->next = freelist;
+  freelist = idx;
+  used--;
+}
+
+void DwellTable::seen(uint16_t hash, uint32_t now) {
+  if (!entries)
+    return;
+
+  uint16_t *bucket = &buckets[hash & (size - 1)];
+  uint16_t idx = *bucket;
+
+  // known device -> update last seen and make it most recent
+  while (idx != DWELL_NIL) {
+    if (entries[idx].hash == hash) {
+      entries[idx].last = now;
+      unlinkLRU(idx);
+      pushLRU(idx);
+      return;
+    }
+    idx = entries[idx].next;
+  }
+
+  // new device -> if table is full, least recently seen device has left
+  if (freelist == DWELL_NIL)
+    finish(oldest);
+
+  idx = freelist;
+  freelist = entries[idx].next;
+  entries[idx].hash = hash;
+  entries[idx].first = entries[idx].last = now;
+  entries[idx].next = *bucket;
+  *bucket = idx;
+  pushLRU(idx);
+  used++;
+}
+
+// finish all visits of devices not seen for timeout seconds
+void DwellTable::expire(uint32_t now, uint32_t timeout) {
+  if (!entries)
+    return;
+  while ((oldest != DWELL_NIL) && (now - entries[oldest].last >= timeout))
+    finish(oldest);
+}
@@ -0,0 +1,28 @@
+// clang-format off
+
+#ifndef _NATIVE_H
+#define _NATIVE_H
+
+#include <stdint.h>
+
+// Definitions for native build on a Linux host, see [env:native] in
+// platformio.ini and lib/NativeShim. No radio, no peripherals; LoRa and SPI
+// senders compile to their empty variants, payloads end in SendPayload().
+
+#define NATIVE 1
+
+#define HAS_LED NOT_A_PIN // no LED on host
+
+// optional counting and sending features of paxcounter.conf, all enabled on
+// host, so benchmark and tests cover them
+#define COUNT_WINDOWS 1, 5, 15, 60
+#define DWELL_ENTRIES 1024
+#define CROSS_DEDUP 2048
+#define COUNT_BANDS -65, -80
+#define COUNT_VISITS 1
+#define SNAPSHOT_SIZE 4096
+#define PROBE_FINGERPRINT 256
+#define SEND_AGGREGATE 1
+#define COUNT_SERIES 96
+
+#endif
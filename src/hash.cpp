@@ -85,3 +85,55 @@ uint32_t IRAM_ATTR rokkit(const char *data, int len) {
 
   return hash;
 }
+
+/*
+ * Salted MAC hashing without string formatting
+ *
+ * The 6 MAC bytes are loaded as two integers and mixed together with a
+ * 32bit salt using the MurmurHash3 block and finalizer steps. The result is
+ * folded to 16 bit for the MAC container.
+ */
+
+static inline uint32_t rotl32(uint32_t x, int8_t r) {
+  return (x << r) | (x >> (32 - r));
+}
+
+uint32_t IRAM_ATTR mac_hash32(const uint8_t *paddr, uint32_t salt) {
+  uint32_t lo = ((uint32_t)paddr[0]) | ((uint32_t)paddr[1] << 8) |
+                ((uint32_t)paddr[2] << 16) | ((uint32_t)paddr[3] << 24);
+  uint32_t hi = ((uint32_t)paddr[4]) | ((uint32_t)paddr[5] << 8);
+  uint32_t h = salt;
+
+  lo *= 0xcc9e2d51;
+  lo = rotl32(lo, 15);
+  lo *= 0x1b873593;
+  h ^= lo;
+  h = rotl32(h, 13);
+  h = h * 5 + 0xe6546b64;
+
+  hi *= 0xcc9e2d51;
+  hi = rotl32(hi, 15);
+  hi *= 0x1b873593;
+  h ^= hi;
+
+  h ^= 6; // length of MAC
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+
+  return h;
+}
+
+uint16_t IRAM_ATTR mac_hash(const uint8_t *paddr, uint32_t salt) {
+  uint32_t h = mac_hash32(paddr, salt);
+  return (uint16_t)(h ^ (h >> 16));
+}
+
+// hashes n MACs found at paddr, paddr + stride, ... into hashes[]
+void IRAM_ATTR mac_hash_batch(const uint8_t *paddr, size_t stride,
+                              uint16_t *hashes, uint16_t n, uint32_t salt) {
+  for (uint16_t i = 0; i < n; i++, paddr += stride)
+    hashes[i] = mac_hash(paddr, salt);
+}
@@ -0,0 +1,91 @@
+#include "hyperloglog.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+HyperLogLog::HyperLogLog(uint8_t p) {
+  if (p < HLL_PRECISION_MIN)
+    p = HLL_PRECISION_MIN;
+  if (p > HLL_PRECISION_MAX)
+    p = HLL_PRECISION_MAX;
+  precision = p;
+  size = 1 << p;
+  registers = (uint8_t *)malloc(size);
+  clear();
+}
+
+HyperLogLog::~HyperLogLog(void) { free(registers); }
+
+void HyperLogLog::clear(void) {
+  if (registers)
+    memset(registers, 0, size);
+}
+
+uint8_t HyperLogLog::getPrecision(void) const { return precision; }
+
+uint16_t HyperLogLog::getSize(void) const { return size; }
+
+const uint8_t *HyperLogLog::getRegisters(void) const { return registers; }
+
+// first p bits of hash select the register, the position of the leftmost
+// 1-bit in the remaining bits is the rank stored in the register
+bool HyperLogLog::add(uint32_t hash) {
+  const uint16_t idx = hash >> (32 - precision);
+  const uint32_t w = hash << precision;
+  const uint8_t rank = w ? __builtin_clz(w) + 1 : 32 - precision + 1;
+  if (registers[idx] >= rank)
+    return false;
+  registers[idx] = rank;
+  return true;
+}
+
+void HyperLogLog::merge(const HyperLogLog &other) {
+  if (other.precision == precision)
+    merge(other.registers, 0, other.size);
+}
+
+// merge a received chunk of registers, starting at register offset
+bool HyperLogLog::merge(const uint8_t *regs, uint16_t offset, uint16_t count) {
+  if (offset + count > size)
+    return false;
+  for (uint16_t i = 0; i < count; i++)
+    if (regs[i] > registers[offset + i])
+      registers[offset + i] = regs[i];
+  return true;
+}
+
+uint32_t HyperLogLog::estimate(void) const {
+  const double m = size;
+  double alpha, sum = 0, e;
+  uint16_t zeros = 0;
+
+  switch (size) {
+  case 16:
+    alpha = 0.673;
+    break;
+  case 32:
+    alpha = 0.697;
+    break;
+  case 64:
+    alpha = 0.709;
+    break;
+  default:
+    alpha = 0.7213 / (1.0 + 1.079 / m);
+  }
+
+  for (uint16_t i = 0; i < size; i++) {
+    sum += ldexp(1.0, -registers[i]);
+    if (!registers[i])
+      zeros++;
+  }
+
+  e = alpha * m * m / sum;
+
+  if ((e <= 2.5 * m) && zeros) // small range correction: linear counting
+    e = m * log(m / zeros);
+  else if (e > 4294967296.0 / 30.0) // large range correction for 32bit hash
+    e = -4294967296.0 * log(1.0 - e / 4294967296.0);
+
+  return (uint32_t)(e + 0.5);
+}
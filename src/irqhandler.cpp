@@ -34,6 +34,10 @@ void irqHandler(void *pvParameters) {
     if (InterruptStatus & CYCLIC_IRQ)
       doHousekeeping();
 
+    // beacon alarms pending?
+    if (InterruptStatus & BEACON_IRQ)
+      sendBeaconAlarms();
+
     // is time to send the payload?
     if (InterruptStatus & SENDCOUNTER_IRQ)
       sendCounter();
@@ -1,5 +1,6 @@
 // Basic Config
 #include "lorawan.h"
+#include "sendscheduler.h"
 
 // Local logging Tag
 static const char TAG[] = "lora";
@@ -7,7 +8,13 @@ static const char TAG[] = "lora";
 #ifdef HAS_LORA
 
 osjob_t sendjob;
-QueueHandle_t LoraSendQueue;
+
+// send queue, shared by producers and LMIC job, guarded by spinlock
+static void lora_release(MessageBuffer_t *message) {
+  sendpool.release(message);
+}
+static SendScheduler LoraSendQueue(SEND_QUEUE_SIZE, lora_release);
+static portMUX_TYPE queueMux = portMUX_INITIALIZER_UNLOCKED;
 
 class MyHalConfig_t : public Arduino_LMIC::HalConfiguration_t {
 
@@ -328,21 +335,25 @@ void switch_lora(uint8_t sf, uint8_t tx) {
 }
 
 void lora_send(osjob_t *job) {
-  MessageBuffer_t SendBuffer;
+  MessageBuffer_t *SendBuffer;
   // Check if there is a pending TX/RX job running, if yes don't eat data
   // since it cannot be sent right now
   if ((LMIC.opmode & (OP_JOINING | OP_REJOIN | OP_TXDATA | OP_POLL)) != 0) {
     // waiting for LoRa getting ready
   } else {
-    if (xQueueReceive(LoraSendQueue, &SendBuffer, (TickType_t)0) == pdTRUE) {
-      // SendBuffer now filled with next payload from queue
-      if (!LMIC_setTxData2(SendBuffer.MessagePort, SendBuffer.Message,
-                           SendBuffer.MessageSize, (cfg.countermode & 0x02))) {
-        ESP_LOGI(TAG, "%d byte(s) sent to LoRa", SendBuffer.MessageSize);
+    portENTER_CRITICAL(&queueMux);
+    SendBuffer = LoraSendQueue.pop();
+    portEXIT_CRITICAL(&queueMux);
+    if (SendBuffer) {
+      // SendBuffer now points to next payload from queue, LMIC copies it
+      if (!LMIC_setTxData2(SendBuffer->MessagePort, SendBuffer->Message,
+                           SendBuffer->MessageSize, (cfg.countermode == 2))) {
+        ESP_LOGI(TAG, "%d byte(s) sent to LoRa", SendBuffer->MessageSize);
       } else {
         ESP_LOGE(TAG, "could not send %d byte(s) to LoRa",
-                 SendBuffer.MessageSize);
+                 SendBuffer->MessageSize);
       }
+      sendpool.release(SendBuffer);
       // sprintf(display_line7, "PACKET QUEUED");
     }
   }
@@ -358,13 +369,7 @@ esp_err_t lora_stack_init() {
 #ifndef HAS_LORA
   return ESP_OK; // continue main program
 #else
-  LoraSendQueue = xQueueCreate(SEND_QUEUE_SIZE, sizeof(MessageBuffer_t));
-  if (LoraSendQueue == 0) {
-    ESP_LOGE(TAG, "Could not create LORA send queue. Aborting.");
-    return ESP_FAIL;
-  }
-  ESP_LOGI(TAG, "LORA send queue created, size %d Bytes",
-           SEND_QUEUE_SIZE * PAYLOAD_BUFFER_SIZE);
+  ESP_LOGI(TAG, "LORA send queue created, size %d messages", SEND_QUEUE_SIZE);
 
   ESP_LOGI(TAG, "Starting LMIC...");
 
@@ -398,21 +403,89 @@ esp_err_t lora_stack_init() {
 }
 
 void lora_enqueuedata(MessageBuffer_t *message) {
-  // enqueue message in LORA send queue
+  // enqueue reference to message in LORA send queue
 #ifdef HAS_LORA
-  BaseType_t ret =
-      xQueueSendToBack(LoraSendQueue, (void *)message, (TickType_t)0);
-  if (ret == pdTRUE) {
+  sendpool.retain(message);
+  portENTER_CRITICAL(&queueMux);
+  const bool ret = LoraSendQueue.push(message);
+  portEXIT_CRITICAL(&queueMux);
+  if (ret) {
     ESP_LOGI(TAG, "%d bytes enqueued for LORA interface", message->MessageSize);
   } else {
-    ESP_LOGW(TAG, "LORA sendqueue is full");
+    ESP_LOGW(TAG, "LORA sendqueue is full, class %d message dropped",
+             message->MessagePrio);
   }
 #endif
 }
 
 void lora_queuereset(void) {
 #ifdef HAS_LORA
-  xQueueReset(LoraSendQueue);
+  portENTER_CRITICAL(&queueMux);
+  LoraSendQueue.clear();
+  portEXIT_CRITICAL(&queueMux);
+#endif
+}
+
+uint8_t lora_queuewaiting(void) {
+#ifdef HAS_LORA
+  return LoraSendQueue.getCount();
+#else
+  return 0;
+#endif
+}
+
+// messages queued, superseded and dropped per send class since start
+const SendStats_t *lora_sendstats(uint8_t cls) {
+#ifdef HAS_LORA
+  return LoraSendQueue.getStats(cls);
+#else
+  return NULL;
+#endif
+}
+
+// maximum application payload at current datarate, without MAC options in
+// frame header, see LoRaWAN regional parameters; capped by payload buffer
+uint8_t lora_maxpayload(void) {
+#ifndef HAS_LORA
+  return PAYLOAD_BUFFER_SIZE;
+#else
+  uint8_t max;
+  switch (LMIC.datarate) {
+#if defined(CFG_us915)
+  case DR_SF10:
+    max = 11;
+    break;
+  case DR_SF9:
+    max = 53;
+    break;
+  case DR_SF8:
+    max = 125;
+    break;
+#else
+  case DR_SF12:
+  case DR_SF11:
+  case DR_SF10:
+    max = 51;
+    break;
+  case DR_SF9:
+    max = 115;
+    break;
+#endif
+  default:
+    max = 222;
+  }
+  return max < PAYLOAD_BUFFER_SIZE ? max : PAYLOAD_BUFFER_SIZE;
+#endif
+}
+
+// true while counts can not go out in time, because the node has not joined
+// yet or earlier messages are still waiting in the send queue
+bool lora_busy(void) {
+#ifndef HAS_LORA
+  return false;
+#else
+  return (LMIC.opmode & (OP_JOINING | OP_REJOIN)) ||
+         LoraSendQueue.getCount();
 #endif
 }
 
@@ -0,0 +1,109 @@
+// Basic Config
+#include "macbitmap.h"
+#include "varint.h"
+
+MacBitmap::MacBitmap() { clear(); }
+
+std::pair<uint16_t, bool> IRAM_ATTR MacBitmap::insert(uint16_t value) {
+  uint32_t *word = &bits[value >> 5];
+  const uint32_t mask = (uint32_t)1 << (value & 0x1F);
+  const bool added = (*word & mask) == 0;
+  *word |= mask;
+  return std::make_pair(value, added);
+}
+
+// returns 1 if value was stored, like std::set<uint16_t>::erase()
+size_t IRAM_ATTR MacBitmap::erase(uint16_t value) {
+  uint32_t *word = &bits[value >> 5];
+  const uint32_t mask = (uint32_t)1 << (value & 0x1F);
+  const size_t erased = (*word & mask) ? 1 : 0;
+  *word &= ~mask;
+  return erased;
+}
+
+// add all values of other
+void MacBitmap::merge(const MacBitmap &other) {
+  for (uint16_t i = 0; i < MACBITMAP_WORDS; i++)
+    bits[i] |= other.bits[i];
+}
+
+bool IRAM_ATTR MacBitmap::contains(uint16_t value) const {
+  return (bits[value >> 5] & ((uint32_t)1 << (value & 0x1F))) != 0;
+}
+
+// number of unique hashes stored, counted by population count of all words
+size_t MacBitmap::size(void) const {
+  size_t count = 0;
+  for (uint16_t i = 0; i < MACBITMAP_WORDS; i++)
+    count += __builtin_popcount(bits[i]);
+  return count;
+}
+
+// number of devices: bits set while shortfall is below 1%, then linear
+// counting estimate m * ln(m / unset bits), limited to 16bit
+uint16_t MacBitmap::estimate(bool *estimated) const {
+  const size_t n = size();
+  *estimated = n > MACBITMAP_EXACT;
+  if (!*estimated)
+    return n;
+  const double lc = MACBITMAP_BITS *
+                    log((double)MACBITMAP_BITS /
+                        (n < MACBITMAP_BITS ? MACBITMAP_BITS - n : 1));
+  return lc < 65535 ? (uint16_t)(lc + 0.5) : 65535;
+}
+
+// serialize to buf, sparse as gaps between set bits while that is shorter
+// than raw words, returns bytes written, 0 if buf is too small
+size_t MacBitmap::save(uint8_t *buf, size_t len) const {
+  size_t n = 1;
+  uint32_t next = 0; // smallest hash value the next one can have
+
+  if (!len)
+    return 0;
+  buf[0] = MACBITMAP_SPARSE;
+  n += put_varint(buf, n, len, size());
+  for (uint16_t i = 0; (i < MACBITMAP_WORDS) && (n < MACBITMAP_SAVED_MAX);
+       i++)
+    for (uint32_t word = bits[i]; word; word &= word - 1) {
+      const uint32_t value = i * 32 + __builtin_ctz(word);
+      n += put_varint(buf, n, len, value - next);
+      next = value + 1;
+    }
+  if (n < MACBITMAP_SAVED_MAX)
+    return n <= len ? n : 0;
+
+  if (len < MACBITMAP_SAVED_MAX)
+    return 0;
+  buf[0] = MACBITMAP_RAW;
+  memcpy(buf + 1, bits, sizeof(bits));
+  return MACBITMAP_SAVED_MAX;
+}
+
+// restore from buf as written by save(), returns bytes read, 0 if invalid
+size_t MacBitmap::load(const uint8_t *buf, size_t len) {
+  size_t n = 1, k;
+  uint32_t count, gap, next = 0;
+
+  clear();
+  if (!len)
+    return 0;
+  if (buf[0] == MACBITMAP_RAW) {
+    if (len < MACBITMAP_SAVED_MAX)
+      return 0;
+    memcpy(bits, buf + 1, sizeof(bits));
+    return MACBITMAP_SAVED_MAX;
+  }
+  if (buf[0] != MACBITMAP_SPARSE || !(k = get_varint(buf, n, len, &count)))
+    return 0;
+  for (n += k; count; count--, n += k) {
+    if (!(k = get_varint(buf, n, len, &gap)) || next + gap >= MACBITMAP_BITS) {
+      clear();
+      return 0;
+    }
+    insert(next + gap);
+    next += gap + 1;
+  }
+  return n;
+}
+
+void MacBitmap::clear(void) { memset(bits, 0, sizeof(bits)); }
@@ -0,0 +1,169 @@
+/* Decouples the sniffer callbacks from MAC processing: the Wifi promiscuous
+   and BLE GAP callbacks only push raw records to lock-free rings, the macloop
+   task drains them in batches and does hashing, counting and alarming */
+
+// Basic Config
+#include "macqueue.h"
+#include "wifiscan.h"
+
+// Local logging tag
+static const char TAG[] = "main";
+
+TaskHandle_t macLoopTask = NULL;
+static volatile bool draining = false; // macloop is processing records
+
+static RingBuffer<MacRecord_t, MAC_QUEUE_SIZE> wifi_ring; // wifi driver task
+#ifdef BLECOUNTER
+static RingBuffer<MacRecord_t, MAC_QUEUE_SIZE> ble_ring; // bluetooth task
+#endif
+#ifdef PROBE_FINGERPRINT
+static ProbeClusters probeclusters(PROBE_FINGERPRINT,
+                                   PROBE_CLUSTER_WINDOW * 1000UL,
+                                   PROBE_SEQ_GAP);
+#endif
+
+// called by sniffer callbacks, must be cheap and never block
+bool IRAM_ATTR mac_enqueue(const uint8_t *paddr, int8_t rssi, uint8_t channel,
+                           uint8_t sniff_type, uint32_t fingerprint,
+                           uint16_t seq) {
+  MacRecord_t rec;
+  uint16_t fill;
+
+  memcpy(rec.mac, paddr, 6);
+  rec.rssi = rssi;
+  rec.channel = channel;
+  rec.timestamp = millis();
+#ifdef PROBE_FINGERPRINT
+  rec.fingerprint = fingerprint;
+  rec.seq = seq;
+#endif
+
+#ifdef BLECOUNTER
+  if (sniff_type == MAC_SNIFF_BLE)
+    fill = ble_ring.push(rec);
+  else
+#endif
+    fill = wifi_ring.push(rec);
+
+  // wake up macloop only if ring was empty, otherwise it is still draining
+  if ((fill == 1) && (macLoopTask != NULL))
+    xTaskNotifyGive(macLoopTask);
+
+  return fill > 0;
+}
+
+// process one batch of records from a ring, returns number of records
+template <class R> static uint16_t mac_drain(R &ring, uint8_t sniff_type) {
+  static MacRecord_t batch[MAC_BATCH_SIZE];
+  static uint16_t hashes[MAC_BATCH_SIZE];
+  uint16_t n = ring.pop(batch, MAC_BATCH_SIZE);
+  uint8_t type[MAC_BATCH_SIZE];
+  const int64_t start = esp_timer_get_time();
+
+  if (!n)
+    return 0;
+
+  for (uint16_t i = 0; i < n; i++) {
+    type[i] = sniff_type;
+#ifdef PROBE_FINGERPRINT
+    // randomized MACs of one device are counted as the first MAC of cluster
+    if (batch[i].fingerprint) {
+      memcpy(batch[i].mac,
+             probeclusters.match(batch[i].fingerprint, batch[i].seq,
+                                 batch[i].mac, batch[i].timestamp),
+             6);
+      type[i] = MAC_SNIFF_PROBE;
+    }
+#endif
+  }
+
+  // counting state and salt are shared with irq handler and remote commands
+  COUNT_MUTEX_LOCK();
+  mac_hash_batch(batch[0].mac, sizeof(MacRecord_t), hashes, n, salt);
+  for (uint16_t i = 0; i < n; i++) {
+    if (!mac_add(batch[i].mac, hashes[i], batch[i].rssi, type[i]))
+      continue;
+    // new devices make the channel they were found on more attractive
+    if (type[i] != MAC_SNIFF_BLE)
+      channel_hit(batch[i].channel);
+#ifdef CROSS_DEDUP
+    cross_add(batch[i].mac, type[i], batch[i].channel, batch[i].rssi,
+              batch[i].timestamp);
+#endif
+  }
+  COUNT_MUTEX_UNLOCK();
+  perf_batch(n, esp_timer_get_time() - start);
+  return n;
+}
+
+// process one batch of each sniffer ring, returns number of records
+uint16_t mac_queue_process(void) {
+  uint16_t n = mac_drain(wifi_ring, MAC_SNIFF_WIFI);
+#ifdef BLECOUNTER
+  n += mac_drain(ble_ring, MAC_SNIFF_BLE);
+#endif
+  return n;
+}
+
+// MAC counting task, drains sniffer rings until they are empty
+void mac_loop(void *pvParameters) {
+
+  configASSERT(((uint32_t)pvParameters) == 1); // FreeRTOS check
+
+  while (1) {
+    // wait for producer's wakeup, timeout catches any missed notification
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MAC_DRAIN_TIMEOUT_MS));
+    draining = true;
+    while (mac_queue_process())
+      ;
+    draining = false;
+  }
+  vTaskDelete(NULL); // shoud never be reached
+}
+
+void mac_queue_init(void) {
+  ESP_LOGI(TAG, "MAC rings created, size %d records each", MAC_QUEUE_SIZE);
+  ESP_LOGI(TAG, "Starting MAC counter...");
+  xTaskCreatePinnedToCore(mac_loop,     // task function
+                          "macloop",    // name of task
+                          3072,         // stack size of task
+                          (void *)1,    // parameter of the task
+                          2,            // priority of the task
+                          &macLoopTask, // task handle
+                          1);           // CPU core
+}
+
+// true if all records pushed so far are counted
+bool mac_queue_idle(void) {
+#ifdef BLECOUNTER
+  if (!ble_ring.empty())
+    return false;
+#endif
+  return !draining && wifi_ring.empty();
+}
+
+// number of records lost due to full ring since device start
+uint32_t mac_queue_dropped(uint8_t sniff_type) {
+#ifdef BLECOUNTER
+  if (sniff_type == MAC_SNIFF_BLE)
+    return ble_ring.getDropped();
+#endif
+  return wifi_ring.getDropped();
+}
+
+// maximum ring fill level since device start
+uint16_t mac_queue_highwater(uint8_t sniff_type) {
+#ifdef BLECOUNTER
+  if (sniff_type == MAC_SNIFF_BLE)
+    return ble_ring.getHighwater();
+#endif
+  return wifi_ring.getHighwater();
+}
+
+#ifdef PROBE_FINGERPRINT
+// probe requests with randomized MAC since device start
+uint32_t mac_queue_probes(void) { return probeclusters.getProbes(); }
+
+// of these, probes which joined a cluster with a different MAC
+uint32_t mac_queue_merged(void) { return probeclusters.getMerged(); }
+#endif
@@ -5,23 +5,368 @@
 #ifdef VENDORFILTER
 #include "vendor_array.h"
 #endif
+#include "beacon_array.h"
+#include "irqhandler.h"
+#include "perfstats.h"
+#ifdef SNAPSHOT_SIZE
+#include "snapshot.h"
+#include <nvs.h>
+#include <rom/rtc.h>
+#endif
 
 // Local logging tag
 static const char TAG[] = "main";
 
-uint16_t salt;
+uint32_t salt, epoch; // epoch counts salts, so it numbers send cycles
 
-uint16_t get_salt(void) {
-  salt = (uint16_t)random(65536); // get new 16bit random for salting hashes
+uint32_t get_salt(void) {
+  salt = esp_random(); // get new 32bit random for salting hashes
+  epoch++;
   return salt;
 }
 
-int8_t isBeacon(uint64_t mac) {
-  it = std::find(beacons.begin(), beacons.end(), mac);
-  if (it != beacons.end())
-    return std::distance(beacons.begin(), it);
-  else
-    return -1;
+uint32_t uptime_seconds(void) {
+  return (uint32_t)(esp_timer_get_time() / 1000000LL);
+}
+
+#if defined(COUNT_WINDOWS) || defined(DWELL_ENTRIES)
+
+// sliding windows and dwell times need identifiers which are stable across
+// send cycles, so they use their own salt, which is renewed after
+// LONG_SALT_HOURS
+static uint32_t longsalt, longsaltexpiry;
+
+uint32_t window_minute(void) { return uptime_seconds() / 60; }
+
+uint16_t long_hash(const uint8_t *paddr) { return mac_hash(paddr, longsalt); }
+
+static void longsalt_renew(void) {
+  longsalt = esp_random();
+  longsaltexpiry = window_minute() + LONG_SALT_HOURS * 60;
+  // old identifiers are meaningless with new salt
+#ifdef COUNT_WINDOWS
+  countwindow.clear();
+#endif
+#ifdef DWELL_ENTRIES
+  dwelltable.clear();
+#endif
+}
+
+// called once per send cycle, after counts were taken
+void longsalt_check(void) {
+  if (window_minute() >= longsaltexpiry) {
+    ESP_LOGI(TAG, "Long lived salt renewed, window counts and dwell times "
+                  "restart");
+    longsalt_renew();
+  }
+}
+
+#endif
+
+#ifdef COUNT_WINDOWS
+
+CountWindow countwindow;
+
+void window_init(void) {
+#ifndef BOARD_HAS_PSRAM
+  uint8_t *arena = (uint8_t *)malloc(COUNTWINDOW_SIZE);
+#else
+  uint8_t *arena = (uint8_t *)ps_malloc(COUNTWINDOW_SIZE);
+#endif
+  if (arena == NULL) {
+    ESP_LOGE(TAG, "Could not allocate sliding window store");
+    return;
+  }
+  countwindow.begin(arena);
+  longsalt_renew();
+  ESP_LOGI(TAG, "Sliding window store created, size %u Bytes",
+           (unsigned)COUNTWINDOW_SIZE);
+}
+
+#endif // COUNT_WINDOWS
+
+#ifdef DWELL_ENTRIES
+
+DwellTable dwelltable;
+
+void dwell_init(void) {
+  static_assert((DWELL_ENTRIES & (DWELL_ENTRIES - 1)) == 0,
+                "DWELL_ENTRIES must be a power of 2");
+  static_assert(DWELL_ENTRIES < DWELL_NIL, "DWELL_ENTRIES too large");
+  const size_t size = DwellTable::arenaSize(DWELL_ENTRIES);
+#ifndef BOARD_HAS_PSRAM
+  void *arena = malloc(size);
+#else
+  void *arena = ps_malloc(size);
+#endif
+  if (arena == NULL) {
+    ESP_LOGE(TAG, "Could not allocate dwell time table");
+    return;
+  }
+  dwelltable.begin(arena, DWELL_ENTRIES);
+  longsalt_renew();
+  ESP_LOGI(TAG, "Dwell time table created, size %u Bytes", (unsigned)size);
+}
+
+#endif // DWELL_ENTRIES
+
+#ifdef CROSS_DEDUP
+
+CrossDedup crossdedup(CROSS_DEDUP, CROSS_WINDOW * 1000UL, CROSS_RSSI_DIFF);
+
+// called for each device newly counted; Wifi MACs without the locally
+// administered bit and public BLE addresses are unique and can be linked
+void cross_add(const uint8_t *paddr, uint8_t sniff_type, uint8_t addrtype,
+               int8_t rssi, uint32_t now) {
+  const bool ble = sniff_type == MAC_SNIFF_BLE;
+  const bool linkable = ble ? addrtype == BLE_ADDR_TYPE_PUBLIC
+                            : (sniff_type == MAC_SNIFF_WIFI) &&
+                                  !(paddr[0] & 0x02);
+  if (crossdedup.add(paddr, ble ? CROSS_BLE : CROSS_WIFI, linkable, rssi, now,
+                     salt))
+    macs_total--; // device is already counted on other technology
+}
+
+#endif // CROSS_DEDUP
+
+// devices counted on both Wifi and BLE in this send cycle
+uint16_t mac_both(void) {
+#ifdef CROSS_DEDUP
+  return crossdedup.getBoth();
+#else
+  return 0;
+#endif
+}
+
+#ifdef COUNT_BANDS
+
+RssiBands rssibands(0, 0);
+
+// apply band edges of configuration
+void bands_init(void) {
+  rssibands.setEdges(cfg.rssiband[0], cfg.rssiband[1]);
+  ESP_LOGI(TAG, "RSSI bands: near >= %d dBm, mid >= %d dBm, far below",
+           cfg.rssiband[0], cfg.rssiband[1]);
+}
+
+#endif // COUNT_BANDS
+
+#ifdef COUNT_VISITS
+
+// hashes of the previous send cycle, under the salt of that cycle, stay
+// queryable for one more cycle to tell returning from new devices; so no
+// salt lives longer than two send cycles
+static MacBitmap prevmacs;
+static uint32_t prevsalt;
+static bool prevvalid = false;
+static uint16_t visits = 0, returning = 0;
+
+// called for each sighting, also of devices whose hash collides with one
+// counted before; a device found in previous cycle is taken out there, what
+// remains at the end departed
+static void visit_add(const uint8_t *paddr, bool added) {
+  visits += added;
+  if (prevvalid && prevmacs.erase(mac_hash(paddr, prevsalt)))
+    returning++;
+}
+
+// new, returning and departed devices of this send cycle
+void visits_get(uint16_t *newpax, uint16_t *back, uint16_t *departed) {
+  *newpax = visits > returning ? visits - returning : 0;
+  *back = returning;
+  *departed = prevvalid ? prevmacs.size() : 0;
+}
+
+// start new epoch, call before counters are reset and salt is renewed
+void visits_rotate(void) {
+  prevmacs = macs;
+  prevmacs.merge(blemacs);
+  prevsalt = salt;
+  prevvalid = true;
+  visits = returning = 0;
+}
+
+#endif // COUNT_VISITS
+
+#ifdef SNAPSHOT_SIZE
+
+// RTC slow memory keeps its content across all resets but power on; a
+// snapshot too large for it goes to NVS, but only on restart by command,
+// to spare flash
+static RTC_NOINIT_ATTR uint8_t snapshot_rtc[SNAPSHOT_SIZE];
+
+// NVS of IDF 3.1 keeps a blob within one flash page, so snapshot is split
+// into blobs of keys snapshot0, snapshot1, ... of at most this size
+#define SNAPSHOT_NVS_CHUNK 1984 // bytes
+#define SNAPSHOT_NVS_KEYS                                                      \
+  ((SNAPSHOT_MAX + SNAPSHOT_NVS_CHUNK - 1) / SNAPSHOT_NVS_CHUNK)
+
+static void snapshot_key(char key[12], uint8_t i) {
+  snprintf(key, 12, "snapshot%u", i);
+}
+
+// save salt, counters and unique MACs of current send cycle
+void snapshot_save(bool flash) {
+  const Snapshot_t state = {epoch, salt, macs_total, macs_wifi, macs_ble};
+  nvs_handle handle;
+  esp_err_t err = ESP_OK;
+  char key[12];
+
+  size_t n = snapshot_encode(snapshot_rtc, SNAPSHOT_SIZE, &state, &macs,
+                             &blemacs);
+  if (n) {
+    ESP_LOGD(TAG, "Snapshot saved to RTC memory, %u bytes", (unsigned)n);
+    return;
+  }
+  snapshot_rtc[0] = 0; // invalidate outdated snapshot
+  if (!flash) {
+    ESP_LOGW(TAG, "Snapshot does not fit in %u bytes RTC memory",
+             (unsigned)SNAPSHOT_SIZE);
+    return;
+  }
+
+  uint8_t *buf = (uint8_t *)malloc(SNAPSHOT_MAX);
+  if (buf == NULL) {
+    ESP_LOGE(TAG, "Could not allocate snapshot buffer");
+    return;
+  }
+  n = snapshot_encode(buf, SNAPSHOT_MAX, &state, &macs, &blemacs);
+  if (nvs_open("snapshot", NVS_READWRITE, &handle) == ESP_OK) {
+    for (size_t i = 0; err == ESP_OK && i < n; i += SNAPSHOT_NVS_CHUNK) {
+      snapshot_key(key, i / SNAPSHOT_NVS_CHUNK);
+      err = nvs_set_blob(handle, key, buf + i,
+                         n - i < SNAPSHOT_NVS_CHUNK ? n - i
+                                                    : SNAPSHOT_NVS_CHUNK);
+    }
+    if (err == ESP_OK && nvs_commit(handle) == ESP_OK)
+      ESP_LOGI(TAG, "Snapshot saved to NVS, %u bytes", (unsigned)n);
+    else
+      ESP_LOGE(TAG, "Could not save snapshot to NVS");
+    nvs_close(handle);
+  }
+  free(buf);
+}
+
+// restore state of send cycle interrupted by reset, if any; call before
+// sniffing starts, returns true if salt was restored
+bool snapshot_restore(void) {
+  const int64_t start = esp_timer_get_time();
+  const uint8_t *src = NULL;
+  uint8_t *buf = NULL;
+  size_t len = 0, size, n = 0;
+  uint32_t rtcepoch, nvsepoch;
+  Snapshot_t state;
+  nvs_handle handle;
+  char key[12];
+
+  // after power on RTC memory holds noise, which fails the CRC check
+  if ((len = snapshot_check(snapshot_rtc, SNAPSHOT_SIZE, &rtcepoch)))
+    src = snapshot_rtc;
+
+  // NVS snapshot is used for the start following a restart by command only,
+  // and taken whether used or not, so it never turns stale
+  if (nvs_open("snapshot", NVS_READWRITE, &handle) == ESP_OK) {
+    snapshot_key(key, 0);
+    if (nvs_get_blob(handle, key, NULL, &size) == ESP_OK) {
+      buf = (uint8_t *)malloc(SNAPSHOT_MAX);
+      // join blobs up to the first one missing, stale ones are cut by check
+      for (uint8_t i = 0; buf && i < SNAPSHOT_NVS_KEYS; i++) {
+        snapshot_key(key, i);
+        size = SNAPSHOT_MAX - n;
+        if (nvs_get_blob(handle, key, buf + n, &size) != ESP_OK)
+          break;
+        n += size;
+      }
+      if (buf && rtc_get_reset_reason(0) == SW_CPU_RESET &&
+          (n = snapshot_check(buf, n, &nvsepoch)) &&
+          (src == NULL || nvsepoch > rtcepoch)) {
+        src = buf;
+        len = n;
+      }
+      for (uint8_t i = 0; i < SNAPSHOT_NVS_KEYS; i++) {
+        snapshot_key(key, i);
+        nvs_erase_key(handle, key);
+      }
+      nvs_commit(handle);
+    }
+    nvs_close(handle);
+  }
+
+  const bool restored =
+      src && snapshot_decode(src, len, &state, &macs, &blemacs);
+  if (restored) {
+    epoch = state.epoch;
+    salt = state.salt;
+    macs_total = state.total;
+    macs_wifi = state.wifi;
+    macs_ble = state.ble;
+    ESP_LOGI(TAG,
+             "Snapshot restored from %s, %u bytes, %d Wifi and %d BLE devices "
+             "in %d us",
+             src == buf ? "NVS" : "RTC memory", (unsigned)len, macs_wifi,
+             macs_ble, (int32_t)(esp_timer_get_time() - start));
+  }
+  free(buf);
+  return restored;
+}
+
+#endif // SNAPSHOT_SIZE
+
+#ifdef VENDORFILTER
+// branch-free binary search in sorted OUI table: always log2(VENDORS_COUNT)
+// halving steps, each selecting the half by conditional move, not by branch
+bool isVendor(uint32_t oui) {
+  const uint32_t *base = vendors;
+  uint16_t n = VENDORS_COUNT;
+  while (n > 1) {
+    const uint16_t half = n / 2;
+    base = (base[half] <= oui) ? base + half : base;
+    n -= half;
+  }
+  return *base == oui;
+}
+#endif
+
+// known beacons for monitor mode, shared by counter task (sightings),
+// irq handler (alarms) and remote commands (setup), guarded by spinlock
+static BeaconRegistry beacons(BEACON_SLOTS, BEACON_ALARM_INTERVAL);
+static portMUX_TYPE beaconMux = portMUX_INITIALIZER_UNLOCKED;
+
+void beacon_init(void) {
+  for (uint8_t i = 0; i < sizeof(beacon_defaults) / sizeof(uint64_t); i++)
+    beacon_set(i, beacon_defaults[i]);
+}
+
+bool beacon_set(uint8_t id, uint64_t mac) {
+  portENTER_CRITICAL(&beaconMux);
+  bool ok = beacons.set(id, mac);
+  portEXIT_CRITICAL(&beaconMux);
+  return ok;
+}
+
+uint8_t beacon_alarms(int8_t rssi[], uint8_t ids[], uint8_t max) {
+  portENTER_CRITICAL(&beaconMux);
+  uint8_t n = beacons.collectAlarms(rssi, ids, max);
+  portEXIT_CRITICAL(&beaconMux);
+  return n;
+}
+
+// check if MAC is a known beacon, if so raise alarm, which is sent by irq
+// handler together with all other alarms pending at that time
+static void beacon_check(uint8_t *paddr, int8_t rssi) {
+  uint8_t beaconID, result;
+
+  portENTER_CRITICAL(&beaconMux);
+  result = beacons.seen(macConvert(paddr), rssi, uptime_seconds(), &beaconID);
+  portEXIT_CRITICAL(&beaconMux);
+
+  if (result == BEACON_ALARM) {
+    ESP_LOGI(TAG, "Beacon ID#%d detected", beaconID);
+#if (HAS_LED != NOT_A_PIN) || defined(HAS_RGB_LED)
+    blink_LED(COLOR_WHITE, 2000);
+#endif
+    xTaskNotify(irqHandlerTask, BEACON_IRQ, eSetBits);
+  }
 }
 
 // Display a key
@@ -42,47 +387,65 @@ uint64_t macConvert(uint8_t *paddr) {
          ((uint64_t)paddr[4] << 32) | ((uint64_t)paddr[5] << 40);
 }
 
-bool mac_add(uint8_t *paddr, int8_t rssi, bool sniff_type) {
+// hashedmac must be mac_hash(paddr, salt), see mac_hash_batch()
+bool mac_add(uint8_t *paddr, uint16_t hashedmac, int8_t rssi,
+             uint8_t sniff_type) {
 
-  char buff[16]; // temporary buffer for printf
   bool added = false;
-  int8_t beaconID;    // beacon number in test monitor mode
-  uint16_t hashedmac; // temporary buffer for generated hash value
-  uint32_t addr2int;  // temporary buffer for shortened MAC
-#ifdef VENDORFILTER
-  uint32_t vendor2int; // temporary buffer for Vendor OUI
-#endif
 
-  // only last 3 MAC Address bytes are used for MAC address anonymization
-  // but since it's uint32 we take 4 bytes to avoid 1st value to be 0
-  addr2int = ((uint32_t)paddr[2]) | ((uint32_t)paddr[3] << 8) |
-             ((uint32_t)paddr[4] << 16) | ((uint32_t)paddr[5] << 24);
+  // in beacon monitor mode check if seen MAC is a known beacon
+  if (cfg.monitormode)
+    beacon_check(paddr, rssi);
 
 #ifdef VENDORFILTER
+  uint32_t vendor2int; // temporary buffer for Vendor OUI
+
   vendor2int = ((uint32_t)paddr[2]) | ((uint32_t)paddr[1] << 8) |
                ((uint32_t)paddr[0] << 16);
-  // use OUI vendor filter list only on Wifi, not on BLE
-  if ((sniff_type == MAC_SNIFF_BLE) ||
-      std::find(vendors.begin(), vendors.end(), vendor2int) != vendors.end()) {
+  // use OUI vendor filter list only on Wifi, not on BLE and not on
+  // clustered randomized MACs, which have no vendor OUI
+  if ((sniff_type != MAC_SNIFF_WIFI) || isVendor(vendor2int)) {
 #endif
 
-    // salt and hash MAC, and if new unique one, store identifier in container
-    // and increment counter on display
+    // MAC was salted and hashed by caller, if new unique one, store identifier
+    // in container and increment counter on display
     // https://en.wikipedia.org/wiki/MAC_Address_Anonymization
 
-    snprintf(buff, sizeof(buff), "%08X",
-             addr2int + (uint32_t)salt); // convert usigned 32-bit salted MAC
-                                         // to 8 digit hex string
-    hashedmac = rokkit(&buff[3], 5); // hash MAC last string value, use 5 chars
-                                     // to fit hash in uint16_t container
-    auto newmac = macs.insert(hashedmac); // add hashed MAC, if new unique
+    // in sketch mode feed every MAC to the sketch, using the fleet wide key
+    if (cfg.countermode == 3)
+      sketch.add(mac_hash32(paddr, HLL_KEY));
+
+#if defined(COUNT_WINDOWS) || defined(DWELL_ENTRIES)
+    const uint16_t longhash = long_hash(paddr);
+#endif
+#ifdef COUNT_WINDOWS
+    // update last seen minute in sliding window store
+    countwindow.add(longhash, window_minute());
+#endif
+#ifdef DWELL_ENTRIES
+    // update first/last seen time in dwell time table
+    dwelltable.seen(longhash, uptime_seconds());
+#endif
+
+#ifdef COUNT_BANDS
+    // move device to nearer band if its signal is stronger than before
+    rssibands.add(hashedmac, rssi);
+#endif
+
+    // add hashed MAC to set of its technology, if new unique
+    auto newmac = (sniff_type == MAC_SNIFF_BLE) ? blemacs.insert(hashedmac)
+                                                : macs.insert(hashedmac);
     added = newmac.second ? true
                           : false; // true if hashed MAC is unique in container
+#ifdef COUNT_VISITS
+    visit_add(paddr, added);
+#endif
 
     // Count only if MAC was not yet seen
     if (added) {
+      macs_total++; // until found on other technology, see cross_add()
       // increment counter and one blink led
-      if (sniff_type == MAC_SNIFF_WIFI) {
+      if (sniff_type != MAC_SNIFF_BLE) {
         macs_wifi++; // increment Wifi MACs counter
 #if (HAS_LED != NOT_A_PIN) || defined(HAS_RGB_LED)
         blink_LED(COLOR_GREEN, 50);
@@ -97,32 +460,20 @@ bool mac_add(uint8_t *paddr, int8_t rssi, bool sniff_type) {
       }
 #endif
 
-      // in beacon monitor mode check if seen MAC is a known beacon
-      if (cfg.monitormode) {
-        beaconID = isBeacon(macConvert(paddr));
-        if (beaconID >= 0) {
-          ESP_LOGI(TAG, "Beacon ID#%d detected", beaconID);
-#if (HAS_LED != NOT_A_PIN) || defined(HAS_RGB_LED)
-          blink_LED(COLOR_WHITE, 2000);
-#endif
-          payload.reset();
-          payload.addAlarm(rssi, beaconID);
-          SendPayload(BEACONPORT);
-        }
-      };
-
     } // added
 
-    // Log scan result
+    // Log scan result, MAC only salted, never in clear
     ESP_LOGV(TAG,
-             "%s %s RSSI %ddBi -> MAC %s -> Hash %04X -> WiFi:%d  BLTH:%d -> "
-             "%d Bytes left",
+             "%s %s RSSI %ddBi -> MAC %08X -> Hash %04X -> WiFi:%d  BLTH:%d "
+             "-> %d Bytes left",
              added ? "new  " : "known",
-             sniff_type == MAC_SNIFF_WIFI ? "WiFi" : "BLTH", rssi, buff,
-             hashedmac, macs_wifi, macs_ble, getFreeRAM());
+             sniff_type == MAC_SNIFF_BLE ? "BLTH" : "WiFi", rssi,
+             mac_hash32(paddr, salt), hashedmac, macs_wifi, macs_ble,
+             getFreeRAM());
 
 #ifdef VENDORFILTER
   } else {
+    perf_count(PERF_VENDOR_DROPPED);
     // Very noisy
     // ESP_LOGD(TAG, "Filtered MAC %02X:%02X:%02X:%02X:%02X:%02X",
     // paddr[0],paddr[1],paddr[2],paddr[3],paddr[5],paddr[5]);
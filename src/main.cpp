@@ -34,6 +34,7 @@ spiloop       0     2     reads/writes data on spi interface
 IDLE          0     0     ESP32 arduino scheduler -> runs wifi sniffer
 
 looptask      1     1     arduino core -> runs the LMIC LoRa stack
+macloop       1     2     drains sniffer rings, hashes and counts MACs
 irqhandler    1     1     executes tasks triggered by irq
 gpsloop       1     2     reads data from GPS via serial or i2c
 bmeloop       1     1     reads data from BME sensor via i2c
@@ -68,11 +69,14 @@ uint16_t volatile macs_total = 0, macs_wifi = 0, macs_ble = 0,
 hw_timer_t *channelSwitch = NULL, *sendCycle = NULL, *homeCycle = NULL,
            *displaytimer = NULL; // irq tasks
 TaskHandle_t irqHandlerTask, wifiSwitchTask;
-SemaphoreHandle_t I2Caccess;
+SemaphoreHandle_t I2Caccess, CountAccess;
 
-// container holding unique MAC address hashes with Memory Alloctor using PSRAM,
-// if present
-std::set<uint16_t, std::less<uint16_t>, Mallocator<uint16_t>> macs;
+// fixed size bitmap containers holding unique MAC address hashes, one per
+// technology, so hashes of Wifi and BLE devices never collide
+MacBitmap macs, blemacs;
+
+// HyperLogLog sketch of all MACs seen in sketch counter mode
+HyperLogLog sketch(HLL_PRECISION);
 
 // initialize payload encoder
 PayloadConvert payload(PAYLOAD_BUFFER_SIZE);
@@ -100,6 +104,9 @@ void setup() {
       xSemaphoreGive((I2Caccess)); // Flag the i2c bus available for use
   }
 
+  // mutex guarding counting state, see COUNT_MUTEX_LOCK()
+  CountAccess = xSemaphoreCreateMutex();
+
   // disable brownout detection
 #ifdef DISABLE_BROWNOUT
   // register with brownout is at address DR_REG_RTCCNTL_BASE + 0xd4
@@ -150,6 +157,7 @@ void setup() {
 
   // read (and initialize on first run) runtime settings from NVRAM
   loadConfig(); // includes initialize if necessary
+  payload.setFormat(cfg.payloadformat);
 
 #ifdef BOARD_HAS_PSRAM
   assert(psramFound());
@@ -339,20 +347,6 @@ void setup() {
   timerAttachInterrupt(channelSwitch, &ChannelSwitchIRQ, true);
   timerAlarmWrite(channelSwitch, cfg.wifichancycle * 1000, true);
 
-// show payload encoder
-#if PAYLOAD_ENCODER == 1
-  strcat_P(features, " PLAIN");
-#elif PAYLOAD_ENCODER == 2
-  strcat_P(features, " PACKED");
-#elif PAYLOAD_ENCODER == 3
-  strcat_P(features, " LPPDYN");
-#elif PAYLOAD_ENCODER == 4
-  strcat_P(features, " LPPPKD");
-#endif
-
-  // show compiled features
-  ESP_LOGI(TAG, "Features:%s", features);
-
 #ifdef HAS_LORA
 // output LoRaWAN keys to console
 #ifdef VERBOSE
@@ -360,13 +354,50 @@ void setup() {
 #endif
 #endif
 
+  // preset test beacons for monitor mode
+  beacon_init();
+
+#ifdef SNAPSHOT_SIZE
+  // continue send cycle interrupted by reset, before counting starts
+  strcat_P(features, " SNAP");
+  const bool restored = snapshot_restore();
+#else
+  const bool restored = false;
+#endif
+
+  // start MAC counter task before sniffers start feeding it
+  mac_queue_init();
+
   // start wifi in monitor mode and start channel rotation task on core 0
   ESP_LOGI(TAG, "Starting Wifi...");
   wifi_sniffer_init();
   // initialize salt value using esp_random() called by random() in
   // arduino-esp32 core. Note: do this *after* wifi has started, since
   // function gets it's seed from RF noise
-  get_salt(); // get new 16bit for salting hashes
+  if (!restored)
+    get_salt(); // get new 32bit for salting hashes
+
+#ifdef COUNT_WINDOWS
+  strcat_P(features, " WIN");
+  window_init(); // allocate sliding window store, needs salt from RF noise
+#endif
+
+#ifdef DWELL_ENTRIES
+  strcat_P(features, " DWELL");
+  dwell_init(); // allocate dwell time table, needs salt from RF noise
+#endif
+
+#ifdef COUNT_BANDS
+  strcat_P(features, " BAND");
+  bands_init(); // set RSSI band edges from configuration
+#endif
+
+  // show payload encoder
+  strcat_P(features, " ");
+  strcat_P(features, payload.getFormatName());
+
+  // show compiled features
+  ESP_LOGI(TAG, "Features:%s", features);
 
   // start state machine
   ESP_LOGI(TAG, "Starting Interrupt Handler...");
@@ -0,0 +1,799 @@
+// unit tests of the native build bring their own main(), see test/
+#if defined(NATIVE) && !defined(UNIT_TEST)
+
+// Benchmark runner of the native build, measures the counting and payload
+// hot paths on the host. Correctness is checked by the unit tests.
+// usage: pio run -e native && .pio/build/native/program [scale]
+
+#include "globals.h"
+#include "macqueue.h"
+#include "configmanager.h"
+#include "rcommand.h"
+#include "senddata.h"
+#include "snapshot.h"
+#include "wifiscan.h"
+#include "native/fixtures.h"
+#ifdef VENDORFILTER
+#include "vendor_array.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <malloc.h>
+#include <math.h>
+#include <set>
+#include <vector>
+
+#define MAC_POOL 4096 // distinct MACs fed to the counter, power of 2
+
+static uint8_t pool[MAC_POOL][6];
+
+// frame controls of a mix of frames as seen in a busy venue, mostly from APs
+static const uint16_t frame_mix[16] = {
+    0x0080, 0x0080, 0x0080, 0x0080, // beacon
+    0x0050, 0x0050,                 // probe response
+    0x0040, 0x0040,                 // probe request
+    0x0208, 0x0208, 0x0288,         // (QoS) data from AP
+    0x0108, 0x01c8,                 // (QoS null) data to AP
+    0x00d4, 0x00d4,                 // ACK
+    0x00b0};                        // authentication
+#ifdef PROBE_FINGERPRINT
+// information elements of a typical smartphone probe request
+static const uint8_t probe_ies[] = {
+    0x00, 0x00,                                           // SSID (wildcard)
+    0x01, 0x08, 0x02, 0x04, 0x0b, 0x16, 0x0c, 0x12, 0x18, // supported rates
+    0x24, 0x32, 0x04, 0x30, 0x48, 0x60, 0x6c,             // extended rates
+    0x03, 0x01, 0x06,                                     // DS parameter set
+    0x2d, 0x1a, 0xef, 0x01, 0x1b, 0xff, 0xff, 0x00, 0x00, // HT capabilities
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7f, 0x08, 0x04, 0x00, 0x08, 0x84, 0x00, 0x00, 0x00, 0x40, // ext. caps
+    0xbf, 0x0c, 0x32, 0x70, 0x80, 0x0f, 0xfe, 0xff, 0x00, 0x00, // VHT caps
+    0xfe, 0xff, 0x00, 0x00,
+    0xdd, 0x07, 0x00, 0x50, 0xf2, 0x08, 0x00, 0x10, 0x00, // vendor specific
+    0xdd, 0x0b, 0x00, 0x17, 0xf2, 0x0a, 0x00, 0x01, 0x04, 0x00, 0x00, 0x00,
+    0x00};
+#endif
+
+#ifdef BLECOUNTER
+static esp_ble_gap_cb_param_t scans[ADVERTS];
+#endif
+
+#define FRAME_POOL 1024 // power of 2
+static uint32_t frames[FRAME_POOL][(sizeof(wifi_pkt_rx_ctrl_t) + 24) / 4 + 1];
+static volatile uint32_t sink; // keeps results from being optimized away
+
+// run f(i) for i = 0 .. n-1 and print throughput
+template <class F> static void bench(const char *name, uint32_t n, F f) {
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++)
+    f(i);
+  const double us = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - t0)
+                        .count();
+  printf("%-28s %10u ops %12.0f ops/s %9.1f ns/op\n", name, n, n / us * 1e6,
+         us * 1000 / n);
+}
+
+// wait until mac loop has counted all records pushed by callback benchmarks,
+// so it does not compete with the timed direct calls following; these take
+// the counting lock, which keeps them safe from it anyway
+static void settle(void) {
+  while (!mac_queue_idle())
+    vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+// frames as handed over by Wifi driver, with senders from MAC pool
+static void make_frames(void) {
+  for (uint16_t i = 0; i < FRAME_POOL; i++) {
+    wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)frames[i];
+    uint8_t *hdr = (uint8_t *)frames[i] + sizeof(wifi_pkt_rx_ctrl_t);
+    ppkt->rx_ctrl.rssi = -70;
+    ppkt->rx_ctrl.channel = 1 + i % 13;
+    hdr[0] = frame_mix[i & 15];
+    hdr[1] = frame_mix[i & 15] >> 8;
+    memset(hdr + 4, 0xFF, 6);
+    memcpy(hdr + 10, pool[i & (MAC_POOL - 1)], 6);
+  }
+}
+
+#ifdef BLECOUNTER
+// scan results as handed over by BLE stack, one per advertisement
+static void make_scans(void) {
+  for (uint8_t i = 0; i < ADVERTS; i++) {
+    scans[i].scan_rst.search_evt = ESP_GAP_SEARCH_INQ_RES_EVT;
+    scans[i].scan_rst.ble_addr_type = BLE_ADDR_TYPE_PUBLIC;
+    scans[i].scan_rst.rssi = -70;
+    memcpy(scans[i].scan_rst.bda, pool[i], 6);
+    memcpy(scans[i].scan_rst.ble_adv, adverts[i].data, adverts[i].len);
+    scans[i].scan_rst.adv_data_len = adverts[i].len;
+  }
+}
+#endif
+
+#ifdef CROSS_DEDUP
+// first sightings of one send cycle: pax with a phone seen on Wifi and BLE,
+// half of them with public BLE address next to Wifi MAC, half with random
+// one; pax seen on Wifi only; BLE beacons; returns pax seen on both
+typedef struct {
+  uint32_t time;
+  uint8_t mac[6];
+  uint8_t tech;
+  bool linkable;
+  int8_t rssi;
+} Sighting_t;
+
+static uint16_t make_sightings(std::vector<Sighting_t> &s, uint16_t pax,
+                               uint16_t beacons) {
+  uint16_t both = 0;
+  for (uint16_t i = 0; i < pax + beacons; i++) {
+    Sighting_t w, b;
+    w.time = esp_random() % (cfg.sendcycle * 2 * 1000);
+    w.rssi = -50 - esp_random() % 40;
+    w.tech = CROSS_WIFI;
+    w.linkable = true;
+    memcpy(w.mac, pool[i & (MAC_POOL / 2 - 1)], 6); // vendor OUI
+    w.mac[5] &= 0xF0;
+    b = w;
+    b.tech = CROSS_BLE;
+    b.time += esp_random() % 3000; // phones send on both within seconds
+    b.rssi += esp_random() % 11 - 5;
+    if (i >= pax) { // beacon
+      b.linkable = false;
+      b.time = esp_random() % (cfg.sendcycle * 2 * 1000);
+      b.rssi = -50 - esp_random() % 40;
+      s.push_back(b);
+      continue;
+    }
+    s.push_back(w);
+    if (i % 5 == 4) // Wifi only
+      continue;
+    if (i & 1)
+      b.mac[5] += 1 + i % 2; // public BLE address next to Wifi MAC
+    else {
+      b.linkable = false; // random BLE address
+      for (uint8_t j = 0; j < 6; j++)
+        b.mac[j] = esp_random();
+    }
+    s.push_back(b);
+    both++;
+  }
+  std::sort(s.begin(), s.end(), [](const Sighting_t &x, const Sighting_t &y) {
+    return x.time < y.time;
+  });
+  return both;
+}
+
+// estimate devices seen on both for quiet, busy and crowded venues
+static void check_crossdedup(void) {
+  static const uint16_t venues[][2] = {{20, 5}, {200, 50}, {1000, 200}};
+  for (uint8_t v = 0; v < 3; v++) {
+    std::vector<Sighting_t> s;
+    const uint16_t truth = make_sightings(s, venues[v][0], venues[v][1]);
+    crossdedup.clear();
+    for (auto &x : s)
+      crossdedup.add(x.mac, x.tech, x.linkable, x.rssi, x.time, salt);
+    printf("%-28s %10u pax, both %u of %u (%u by address)\n",
+           "cross dedup", venues[v][0], crossdedup.getBoth(), truth,
+           crossdedup.getLinked());
+  }
+}
+#endif
+
+// salted hash of MAC as done before mac_hash(): last 4 bytes plus salt as
+// hex string, 5 digits of it hashed by rokkit
+static uint16_t legacy_hash(const uint8_t *paddr, uint32_t salt) {
+  char buff[16];
+  const uint32_t addr2int = ((uint32_t)paddr[2]) | ((uint32_t)paddr[3] << 8) |
+                            ((uint32_t)paddr[4] << 16) |
+                            ((uint32_t)paddr[5] << 24);
+  snprintf(buff, sizeof(buff), "%08X", addr2int + salt);
+  return rokkit(&buff[3], 5);
+}
+
+// distinct 16bit hashes of distinct MACs of several OUI distributions, by
+// mac_hash() and legacy_hash(), against the number an ideal random hash
+// yields; shortfalls are devices lost by collisions
+static void check_collisions(void) {
+  static const char *names[] = {"random MACs", "vendor OUIs", "one OUI serial",
+                                "randomized MACs"};
+  static const uint16_t levels[] = {1000, 10000};
+  static MacBitmap now, before;
+  uint8_t mac[6];
+
+  for (uint8_t d = 0; d < sizeof(names) / sizeof(names[0]); d++)
+    for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+      const uint32_t n = levels[l];
+      now.clear();
+      before.clear();
+      for (uint32_t i = 0; i < n; i++) {
+        for (uint8_t b = 0; b < 6; b++)
+          mac[b] = esp_random();
+        switch (d) {
+        case 1: // NIC part random, OUI one of the first 16 of vendor list
+        case 2: // consecutive NIC part, as of a batch of devices
+#ifdef VENDORFILTER
+          mac[0] = vendors[d == 1 ? i % 16 : 0] >> 16;
+          mac[1] = vendors[d == 1 ? i % 16 : 0] >> 8;
+          mac[2] = vendors[d == 1 ? i % 16 : 0];
+#else
+          mac[0] = 0x24;
+          mac[1] = 0x0a;
+          mac[2] = d == 1 ? i % 16 : 0xc4;
+#endif
+          if (d == 2) {
+            mac[3] = 0x10;
+            mac[4] = i >> 8;
+            mac[5] = i;
+          }
+          break;
+        case 3: // locally administered, unicast
+          mac[0] = (mac[0] & 0xFC) | 0x02;
+          break;
+        }
+        now.insert(mac_hash(mac, salt));
+        before.insert(legacy_hash(mac, salt));
+      }
+      const double ideal = 65536.0 * (1 - exp(-(double)n / 65536));
+      printf("%-28s %10u MACs, distinct hashes %u (%.1f%% lost), before %u "
+             "(%.1f%% lost), ideal %.0f\n",
+             names[d], n, (unsigned)now.size(),
+             100.0 * (n - now.size()) / n, (unsigned)before.size(),
+             100.0 * (n - before.size()) / n, ideal);
+    }
+}
+
+// HyperLogLog accuracy against memory: RMS of relative count error over 20
+// sketches per precision and number of devices, and the theoretical
+// standard error 1.04/sqrt(registers); the exact bitmap needs 8 KB
+static void check_sketch(void) {
+  static const uint32_t levels[] = {100, 1000, 10000, 100000};
+  static char name[32];
+  uint8_t mac[6] = {0x02};
+
+  for (uint8_t p = HLL_PRECISION_MIN; p <= HLL_PRECISION_MAX; p++) {
+    HyperLogLog hll(p);
+    double rms[sizeof(levels) / sizeof(levels[0])];
+    for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+      double sum = 0;
+      for (uint8_t run = 0; run < 20; run++) {
+        const uint32_t key = esp_random();
+        hll.clear();
+        for (uint32_t i = 0; i < levels[l]; i++) {
+          memcpy(mac + 2, &i, 4);
+          hll.add(mac_hash32(mac, key));
+        }
+        const double err = ((double)hll.estimate() - levels[l]) / levels[l];
+        sum += err * err;
+      }
+      rms[l] = 100 * sqrt(sum / 20);
+    }
+    snprintf(name, sizeof(name), "sketch precision %u", p);
+    printf("%-28s %10u bytes, std. error %.1f%%, RMS error %.1f%% / %.1f%% / "
+           "%.1f%% / %.1f%% at 100 / 1k / 10k / 100k pax\n",
+           name, hll.getSize(), 104 / sqrt(hll.getSize()), rms[0], rms[1],
+           rms[2], rms[3]);
+  }
+}
+
+// std::set of hashes, as used before the bitmap, versus MacBitmap for few to
+// many devices per send cycle: time per insert, including clearing the
+// container each cycle, and memory used
+static void bench_containers(void) {
+  static const uint32_t levels[] = {1000, 10000, 60000};
+  static MacBitmap bitmap;
+  std::vector<uint16_t> hashes;
+  uint8_t mac[6];
+
+  for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+    const uint32_t rounds = 2000000 / levels[l];
+    std::set<uint16_t> set;
+    size_t heap, setbytes = 0;
+    hashes.clear();
+    for (uint32_t i = 0; i < levels[l]; i++) {
+      for (uint8_t b = 0; b < 6; b++)
+        mac[b] = esp_random();
+      hashes.push_back(mac_hash(mac, salt));
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+      set.clear();
+      heap = mallinfo2().uordblks;
+      for (uint16_t h : hashes)
+        sink += set.insert(h).second;
+      if (!r)
+        setbytes = mallinfo2().uordblks - heap;
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+      bitmap.clear();
+      for (uint16_t h : hashes)
+        sink += bitmap.insert(h).second;
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    const double ops = (double)rounds * levels[l] / 1000;
+    printf("%-28s %10u MACs, %u unique: set %.1f ns/insert, %zu bytes; "
+           "bitmap %.1f ns/insert, %zu bytes\n",
+           "set vs bitmap", levels[l], (unsigned)set.size(),
+           std::chrono::duration<double, std::micro>(t1 - t0).count() / ops,
+           setbytes,
+           std::chrono::duration<double, std::micro>(t2 - t1).count() / ops,
+           sizeof(bitmap));
+  }
+}
+
+// feed millions of distinct MACs in cycles, sending counts after each cycle;
+// prints count error by fill level and heap use after warmup
+static void check_soak(uint32_t n) {
+  static const uint32_t levels[] = {1000, 4000, 10000, 30000, 60000};
+  uint8_t mac[6];
+  size_t heap = 0;
+  bool estimated;
+  for (uint32_t total = 0; total < n;) {
+    const bool last = n - total <= 105000; // sum of levels
+    for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+      COUNT_MUTEX_LOCK(); // sendCounter takes it itself
+      macs.clear();
+      for (uint32_t i = 0; i < levels[l]; i++, total++) {
+        for (uint8_t b = 0; b < 6; b++)
+          mac[b] = esp_random();
+#ifdef VENDORFILTER
+        const uint32_t oui = vendors[i % VENDORS_COUNT];
+        mac[0] = oui >> 16;
+        mac[1] = oui >> 8;
+        mac[2] = oui;
+#endif
+        mac_add(mac, mac_hash(mac, salt), -70, MAC_SNIFF_WIFI);
+      }
+      const uint16_t count = macs.estimate(&estimated);
+      COUNT_MUTEX_UNLOCK();
+      sendCounter(); // also resets counters
+      if (!heap)
+        heap = mallinfo2().uordblks; // after warmup cycle
+      else if (last)
+        printf("%-28s %10u pax, counted %5u%s, error %+.1f%%\n", "soak",
+               levels[l], count, estimated ? " (estimated)" : "",
+               100.0 * ((double)count - levels[l]) / levels[l]);
+    }
+  }
+  printf("%-28s %10u pax, heap %zu -> %zu bytes\n", "soak", n, heap,
+         (size_t)mallinfo2().uordblks);
+  COUNT_MUTEX_LOCK();
+  macs.clear();
+  COUNT_MUTEX_UNLOCK();
+}
+
+#ifdef SNAPSHOT_SIZE
+// snapshot size and encode / decode time for few to many devices, one third
+// of them BLE, see test_counting for round trip checks
+static void bench_snapshot(void) {
+  static const uint16_t levels[] = {100, 1000, 1500, 5000, 30000};
+  static MacBitmap wifi, ble, wifi2, ble2;
+  static uint8_t buf[SNAPSHOT_MAX];
+  for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+    wifi.clear();
+    ble.clear();
+    for (uint16_t i = 0; i < levels[l]; i++)
+      (i % 3 ? wifi : ble).insert(esp_random());
+    const Snapshot_t state = {7, salt, levels[l], (uint16_t)wifi.size(),
+                              (uint16_t)ble.size()};
+    Snapshot_t restored;
+
+    const size_t rtc = snapshot_encode(buf, SNAPSHOT_SIZE, &state, &wifi, &ble);
+    const auto t0 = std::chrono::steady_clock::now();
+    const size_t n = snapshot_encode(buf, sizeof(buf), &state, &wifi, &ble);
+    const auto t1 = std::chrono::steady_clock::now();
+    sink += snapshot_decode(buf, n, &restored, &wifi2, &ble2);
+    const auto t2 = std::chrono::steady_clock::now();
+    printf("%-28s %10u pax, %5u bytes%s, encode %.1f us, decode %.1f us\n",
+           "snapshot", levels[l], (unsigned)n, rtc ? " (RTC)" : "",
+           std::chrono::duration<double, std::micro>(t1 - t0).count(),
+           std::chrono::duration<double, std::micro>(t2 - t1).count());
+  }
+}
+#endif
+
+// each payload format selected by remote command: count records per payload
+// buffer and time to encode status and config
+static void bench_formats(uint32_t n) {
+  static char name[32];
+  for (uint8_t f = PAYLOAD_PLAIN; f <= PAYLOAD_LPP_PACKED; f++) {
+    uint8_t cmd[] = {0x17, f};
+    rcommand(cmd, sizeof(cmd));
+    payload.reset();
+    uint8_t records = 0;
+    while (payload.addCount(records, MAC_SNIFF_WIFI))
+      records++;
+    snprintf(name, sizeof(name), "payload %s", payload.getFormatName());
+    printf("%-28s %10u records, %u of %u bytes\n", name, records,
+           payload.getSize(), PAYLOAD_BUFFER_SIZE);
+    strcat(name, " status+config");
+    bench(name, n, [](uint32_t i) {
+      payload.reset();
+      payload.addStatus(3900, i, 45, i, 1, 1);
+      payload.addConfig(cfg);
+    });
+  }
+  uint8_t cmd[] = {0x17, PAYLOAD_ENCODER};
+  rcommand(cmd, sizeof(cmd));
+}
+
+#ifdef SEND_AGGREGATE
+static std::vector<MessageBuffer_t> sent;
+
+// LoRa airtime of an uplink at 125 kHz, coding rate 4/5, 8 symbols preamble,
+// with 13 bytes LoRaWAN header, port and MIC [milliseconds]
+static double airtime(uint8_t size, uint8_t sf) {
+  const double symbol = (1 << sf) / 125.0;
+  const int lowrate = sf >= 11;
+  const int bits = 8 * (size + 13) - 4 * sf + 28 + 16;
+  const int symbols = (int)ceil(bits / (4.0 * (sf - 2 * lowrate))) * 5;
+  return (8 + 4.25 + 8 + (symbols > 0 ? symbols : 0)) * symbol;
+}
+
+// airtime of one send cycle at maximum payloads of EU SF9 (capped by payload
+// buffer) and US SF10, aggregated versus one frame per record
+static void bench_aggregate(void) {
+  static const uint8_t maxpayload[] = {PAYLOAD_BUFFER_SIZE, 11};
+  native_sent = [](const MessageBuffer_t *message) {
+    sent.push_back(*message);
+  };
+  for (uint8_t d = 0; d < sizeof(maxpayload); d++) {
+    const uint8_t max = maxpayload[d];
+    uint16_t records = 0;
+    double packed = 0, single = 0;
+    native_maxpayload = max;
+    sent.clear();
+    sendCounter();
+    for (const MessageBuffer_t &m : sent) {
+      packed += airtime(m.MessageSize, 9);
+      if (m.MessagePort != AGGREGATEPORT) { // sent as is
+        single += airtime(m.MessageSize, 9);
+        records++;
+        continue;
+      }
+      for (uint8_t i = 0; i + 2 <= m.MessageSize; i += 2 + m.Message[i + 1]) {
+        single += airtime(m.Message[i + 1], 9);
+        records++;
+      }
+    }
+    printf("%-28s %10u records in %u frames of max. %u bytes, airtime SF9 "
+           "%.0f ms, %.0f ms unpacked\n",
+           "aggregate", records, (unsigned)sent.size(), max, packed, single);
+  }
+  native_sent = NULL;
+  native_maxpayload = PAYLOAD_BUFFER_SIZE;
+}
+#endif
+
+#ifdef COUNT_SERIES
+// traces kept while LoRa is busy, encoded in runs of maximum payload and
+// decoded again: bytes per send cycle and time per frame
+static void bench_series(void) {
+  static const char *names[] = {"series office", "series night",
+                                "series random"};
+  static CountSeries series(COUNT_SERIES);
+  static CountSample_t trace[COUNT_SERIES], decoded[COUNTSERIES_RUN];
+  uint8_t buf[PAYLOAD_BUFFER_SIZE];
+
+  for (uint8_t t = 0; t < 3; t++) {
+    uint16_t frames = 0, samples = 0, bytes = 0;
+    double encode = 0, decode = 0;
+    make_trace(trace, t);
+    series.clear();
+    for (uint16_t i = 0; i < COUNT_SERIES; i++)
+      series.add(&trace[i]);
+    while (series.getCount()) {
+      uint8_t taken, seq;
+      const auto t0 = std::chrono::steady_clock::now();
+      const uint8_t n =
+          series.encode(buf, sizeof(buf), COUNTSERIES_BLE, &taken);
+      const auto t1 = std::chrono::steady_clock::now();
+      sink += CountSeries::decode(buf, n, &seq, decoded, COUNTSERIES_RUN);
+      const auto t2 = std::chrono::steady_clock::now();
+      encode += std::chrono::duration<double, std::micro>(t1 - t0).count();
+      decode += std::chrono::duration<double, std::micro>(t2 - t1).count();
+      series.drop(taken);
+      frames++;
+      samples += taken;
+      bytes += n;
+    }
+    printf("%-28s %10u cycles in %u frames, %.1f per frame, %.2f bytes per "
+           "cycle (4 raw), encode %.1f us, decode %.1f us\n",
+           names[t], samples, frames, (double)samples / frames,
+           (double)bytes / samples, encode / frames, decode / frames);
+  }
+}
+#endif
+
+// fake LoRa transport, blocked while not joined for some send cycles, gets
+// counts, a status reply and a battery reading per cycle and a beacon alarm
+// every fourth one, then drained: messages per class, and those a plain FIFO
+// of same size would have kept, namely the first ones only
+static void bench_scheduler(void) {
+  static const char *names[SEND_CLASSES] = {"alarms", "replies", "counts",
+                                            "telemetry"};
+  static SendScheduler *transport;
+  static uint16_t pushed, fifo[SEND_CLASSES];
+  SendScheduler queue(SEND_QUEUE_SIZE,
+                      [](MessageBuffer_t *m) { sendpool.release(m); });
+  uint16_t sent[SEND_CLASSES] = {0};
+
+  transport = &queue;
+  pushed = 0;
+  memset(fifo, 0, sizeof(fifo));
+  native_sent = [](const MessageBuffer_t *message) {
+    MessageBuffer_t *m = (MessageBuffer_t *)message;
+    if (pushed++ < SEND_QUEUE_SIZE)
+      fifo[m->MessagePrio]++;
+    sendpool.retain(m); // as lora_enqueuedata()
+    transport->push(m);
+  };
+  for (uint8_t cycle = 0; cycle < 12; cycle++) {
+    uint8_t cmd[] = {0x81};
+    sendCounter();
+    rcommand(cmd, sizeof(cmd));
+    payload.reset();
+    payload.addVoltage(3700 + cycle);
+    SendPayload(BATTPORT);
+    if (!(cycle % 4)) {
+      payload.reset();
+      payload.addAlarm(-60, cycle);
+      SendPayload(BEACONPORT);
+    }
+  }
+  native_sent = NULL;
+
+  while (MessageBuffer_t *m = queue.pop()) {
+    sent[m->MessagePrio]++;
+    sendpool.release(m); // as lora_send()
+  }
+  for (uint8_t c = 0; c < SEND_CLASSES; c++) {
+    const SendStats_t *stats = queue.getStats(c);
+    printf("%-28s %10u queued, %u superseded, %u dropped, %u sent (FIFO "
+           "%u)\n",
+           names[c], stats->queued,
+           stats->coalesced, stats->dropped, sent[c], fifo[c]);
+  }
+  printf("%-28s %10u messages while blocked\n", "scheduler", pushed);
+}
+
+// peak number of send buffers in use, and bytes moved per message and held
+// by queues, against messages passed by value
+static void bench_sendpool(void) {
+  const uint8_t highwater = sendpool.getHighwater();
+  // per message copied into and out of LoRa and SPI queue, and queue storage
+  const unsigned size = sizeof(MessageBuffer_t), ptr = sizeof(void *);
+  printf("%-28s %10u of %u max. used, %u bytes copied per message (%u by "
+         "value), %u bytes of queues (%u by value)\n",
+         "sendpool", highwater, SEND_POOL_SIZE, 4 * ptr, 4 * size,
+         SEND_POOL_SIZE * size + 2 * SEND_QUEUE_SIZE * ptr,
+         2 * SEND_QUEUE_SIZE * size);
+}
+
+// random MACs, first half with OUIs from vendor filter list
+static void make_pool(void) {
+  for (uint16_t i = 0; i < MAC_POOL; i++) {
+    for (uint8_t b = 0; b < 6; b++)
+      pool[i][b] = esp_random();
+#ifdef VENDORFILTER
+    if (i < MAC_POOL / 2) {
+      const uint32_t oui = vendors[i % VENDORS_COUNT];
+      pool[i][0] = oui >> 16;
+      pool[i][1] = oui >> 8;
+      pool[i][2] = oui;
+    }
+#endif
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const uint32_t scale = argc > 1 ? atoi(argv[1]) : 1;
+  const uint32_t n = 1000000 * scale;
+
+  // same startup sequence as setup() in main.cpp, as far as it applies
+  loadConfig();
+  payload.setFormat(cfg.payloadformat);
+  get_salt();
+#ifdef COUNT_WINDOWS
+  window_init();
+#endif
+#ifdef DWELL_ENTRIES
+  dwell_init();
+#endif
+#ifdef COUNT_BANDS
+  bands_init();
+#endif
+  beacon_init();
+  mac_queue_init();
+  make_pool();
+  make_frames();
+#ifdef BLECOUNTER
+  make_scans();
+#endif
+
+  printf("Paxcounter %s native benchmark, payload encoder %s\n", PROGVERSION,
+         payload.getFormatName());
+
+  bench("mac_hash", n, [](uint32_t i) {
+    sink += mac_hash(pool[i & (MAC_POOL - 1)], salt);
+  });
+
+  bench("snprintf + rokkit (before)", n, [](uint32_t i) {
+    sink += legacy_hash(pool[i & (MAC_POOL - 1)], salt);
+  });
+
+  bench("mac_hash32", n, [](uint32_t i) {
+    sink += mac_hash32(pool[i & (MAC_POOL - 1)], salt);
+  });
+
+  bench("mac_hash_batch (16)", n / 16, [](uint32_t i) {
+    uint16_t hashes[16];
+    mac_hash_batch(pool[(i * 16) & (MAC_POOL - 1)], 6, hashes, 16, salt);
+    sink += hashes[0];
+  });
+
+#ifdef VENDORFILTER
+  bench("isVendor", n, [](uint32_t i) {
+    const uint8_t *p = pool[i & (MAC_POOL - 1)];
+    sink += isVendor((p[0] << 16) | (p[1] << 8) | p[2]);
+  });
+  bench("isVendor, hits", n, [](uint32_t i) {
+    sink += isVendor(vendors[(i * 7919) % VENDORS_COUNT]);
+  });
+
+  // linear search of former std::array table, on a copy of the sorted table
+  static std::array<uint32_t, VENDORS_COUNT> table;
+  std::copy(vendors, vendors + VENDORS_COUNT, table.begin());
+  bench("std::find (before)", n / 10, [](uint32_t i) {
+    const uint8_t *p = pool[i & (MAC_POOL - 1)];
+    sink += std::find(table.begin(), table.end(),
+                      (p[0] << 16) | (p[1] << 8) | p[2]) != table.end();
+  });
+  bench("std::find (before), hits", n / 10, [](uint32_t i) {
+    const uint32_t oui = vendors[(i * 7919) % VENDORS_COUNT];
+    sink += std::find(table.begin(), table.end(), oui) != table.end();
+  });
+
+#endif
+
+  check_collisions();
+
+  // direct calls into counting state, locked against mac loop as in mac_drain
+  COUNT_MUTEX_LOCK();
+  bench("mac_add wifi", n, [](uint32_t i) {
+    uint8_t *p = pool[i & (MAC_POOL - 1)];
+    sink += mac_add(p, mac_hash(p, salt), -70, MAC_SNIFF_WIFI);
+  });
+  printf("%-28s %10u unique of %d MACs\n", "-> counted", macs_wifi, MAC_POOL);
+  bench_containers();
+
+  check_sketch();
+  bench("sketch add", n, [](uint32_t i) {
+    sink += sketch.add(mac_hash32(pool[i & (MAC_POOL - 1)], HLL_KEY));
+  });
+  sketch.clear();
+
+#ifdef COUNT_BANDS
+  bench("rssibands add", n, [](uint32_t i) {
+    rssibands.add(mac_hash(pool[i & (MAC_POOL - 1)], salt), -50 - (i & 63));
+  });
+  printf("%-28s %10u near, %u mid, %u far\n", "->",
+         rssibands.getCount(RSSI_BAND_NEAR), rssibands.getCount(RSSI_BAND_MID),
+         rssibands.getCount(RSSI_BAND_FAR));
+#endif
+
+#ifdef CROSS_DEDUP
+  check_crossdedup();
+  crossdedup.clear();
+  bench("crossdedup add", n, [](uint32_t i) {
+    if (!(i & 1023))
+      crossdedup.clear(); // one send cycle of 1024 new devices
+    sink += crossdedup.add(pool[i & (MAC_POOL - 1)], i & 1, true, -70,
+                           i * 50, salt);
+  });
+#endif
+  COUNT_MUTEX_UNLOCK();
+
+#ifdef PROBE_FINGERPRINT
+  bench("probe_fingerprint", n, [](uint32_t i) {
+    sink += probe_fingerprint(probe_ies, sizeof(probe_ies));
+  });
+#endif
+
+  for (uint8_t profile = WIFI_FILTER_ALL; profile <= WIFI_FILTER_PROBES;
+       profile++) {
+    static const char *names[] = {"wifi callback, filter all",
+                                  "wifi callback, filter clients",
+                                  "wifi callback, filter probes"};
+    uint32_t before = 0, after = 0;
+    wifi_filter_set(profile);
+    for (uint8_t c = 0; c < WIFI_FRAME_CLASSES; c++)
+      before += wifi_filter_passes(c) ? wifi_frames(c) : 0;
+    bench(names[profile], n, [](uint32_t i) {
+      wifi_sniffer_packet_handler(frames[i & (FRAME_POOL - 1)],
+                                  WIFI_PKT_MGMT);
+    });
+    for (uint8_t c = 0; c < WIFI_FRAME_CLASSES; c++)
+      after += wifi_filter_passes(c) ? wifi_frames(c) : 0;
+    printf("%-28s %10u frames passed filter (%.0f%%)\n", "->",
+           after - before, (after - before) * 100.0 / n);
+  }
+  wifi_filter_set(WIFI_FILTER_PROFILE);
+  settle();
+
+#ifdef BLECOUNTER
+  bench("ble_adv_parse", n, [](uint32_t i) {
+    BleAdv_t adv;
+    ble_adv_parse(adverts[i % ADVERTS].data, adverts[i % ADVERTS].len, &adv);
+    sink += adv.fields;
+  });
+
+  bench("ble_classify", n, [](uint32_t i) {
+    sink += ble_classify(adverts[i % ADVERTS].data, adverts[i % ADVERTS].len);
+  });
+
+  bench("ble callback", n, [](uint32_t i) {
+    gap_callback_handler(ESP_GAP_BLE_SCAN_RESULT_EVT, &scans[i % ADVERTS]);
+  });
+  printf("%-28s %10u phone, %u wearable, %u beacon, %u other\n", "->",
+         ble_adverts(BLE_CLASS_PHONE), ble_adverts(BLE_CLASS_WEARABLE),
+         ble_adverts(BLE_CLASS_BEACON), ble_adverts(BLE_CLASS_OTHER));
+  settle();
+#endif
+
+  cfg.monitormode = 1;
+  COUNT_MUTEX_LOCK();
+  bench("mac_add wifi, monitor mode", n, [](uint32_t i) {
+    uint8_t *p = pool[i & (MAC_POOL - 1)];
+    sink += mac_add(p, mac_hash(p, salt), -70, MAC_SNIFF_WIFI);
+  });
+  COUNT_MUTEX_UNLOCK();
+  cfg.monitormode = 0;
+
+  bench("sendCounter", n / 100, [](uint32_t i) {
+    macs_wifi = i;
+    macs_ble = i / 2;
+    sendCounter();
+  });
+
+  bench("payload addCount + Send", n / 10, [](uint32_t i) {
+    payload.reset();
+    payload.addCount(i, MAC_SNIFF_WIFI);
+    payload.addCount(i, MAC_SNIFF_BLE);
+    SendPayload(COUNTERPORT);
+  });
+
+  bench("rcommand get config", n / 10, [](uint32_t i) {
+    uint8_t cmd[] = {0x80};
+    rcommand(cmd, sizeof(cmd));
+  });
+
+  bench("rcommand set rssi + save", n / 100, [](uint32_t i) {
+    uint8_t cmd[] = {0x01, (uint8_t)(i & 0x7f)};
+    rcommand(cmd, sizeof(cmd));
+  });
+
+  printf("%-28s %10u messages, %u bytes\n", "-> sent", native_messages,
+         native_bytes);
+
+  check_soak(n * 4);
+#ifdef SNAPSHOT_SIZE
+  bench_snapshot();
+#endif
+  bench_formats(n / 10);
+#ifdef SEND_AGGREGATE
+  bench_aggregate();
+#endif
+#ifdef COUNT_SERIES
+  bench_series();
+#endif
+  bench_scheduler();
+  bench_sendpool();
+
+  return 0;
+}
+
+#endif // NATIVE && !UNIT_TEST
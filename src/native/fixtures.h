@@ -0,0 +1,104 @@
+#ifndef _NATIVE_FIXTURES_H
+#define _NATIVE_FIXTURES_H
+
+// Hooks of the native stand-ins (see stubs.cpp) and canned input data,
+// shared by benchmark, replay and unit tests (see test/) of the native build
+
+#include "globals.h"
+#include "countseries.h"
+
+#include <math.h>
+
+extern uint32_t native_messages, native_bytes;
+extern uint8_t native_maxpayload;
+extern void (*native_sent)(const MessageBuffer_t *message);
+extern bool native_busy;
+
+#ifdef BLECOUNTER
+// advertising data (and scan response) of common advertisers, with class
+// expected from rules of bleclass_array.h
+#define ADV(...) (const uint8_t[]){__VA_ARGS__}, sizeof((const uint8_t[]){__VA_ARGS__})
+static const struct {
+  const char *name;
+  const uint8_t *data;
+  uint8_t len;
+  uint8_t cls;
+} adverts[] = {
+    {"iPhone nearby info",
+     ADV(0x02, 0x01, 0x1a, 0x0a, 0xff, 0x4c, 0x00, 0x10, 0x05, 0x0b, 0x1c,
+         0x8e, 0x2a, 0x1f),
+     BLE_CLASS_PHONE},
+    {"iBeacon",
+     ADV(0x02, 0x01, 0x06, 0x1a, 0xff, 0x4c, 0x00, 0x02, 0x15, 0xe2, 0xc5,
+         0x6d, 0xb5, 0xdf, 0xfb, 0x48, 0xd2, 0xb0, 0x60, 0xd0, 0xf5, 0xa7,
+         0x10, 0x96, 0xe0, 0x00, 0x01, 0x00, 0x02, 0xc5),
+     BLE_CLASS_BEACON},
+    {"Eddystone UID",
+     ADV(0x02, 0x01, 0x06, 0x03, 0x03, 0xaa, 0xfe, 0x17, 0x16, 0xaa, 0xfe,
+         0x00, 0xe7, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+         0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x00, 0x00),
+     BLE_CLASS_BEACON},
+    {"AirPods",
+     ADV(0x07, 0xff, 0x4c, 0x00, 0x07, 0x19, 0x01, 0x02), BLE_CLASS_WEARABLE},
+    {"exposure notification",
+     ADV(0x02, 0x01, 0x1a, 0x03, 0x03, 0x6f, 0xfd, 0x17, 0x16, 0x6f, 0xfd,
+         0x5a, 0x1e, 0x03, 0x44, 0x91, 0x0c, 0x2d, 0x87, 0x63, 0x10, 0xa8,
+         0x33, 0x09, 0xf1, 0x52, 0x7c, 0x40, 0x00, 0x00, 0x00),
+     BLE_CLASS_PHONE},
+    {"watch by appearance",
+     ADV(0x02, 0x01, 0x06, 0x03, 0x19, 0xc1, 0x00, 0x05, 0x09, 0x57, 0x61,
+         0x74, 0x63),
+     BLE_CLASS_WEARABLE},
+    {"heart rate strap",
+     ADV(0x02, 0x01, 0x06, 0x03, 0x03, 0x0d, 0x18, 0x02, 0x0a, 0x04),
+     BLE_CLASS_WEARABLE},
+    {"Windows computer",
+     ADV(0x06, 0xff, 0x06, 0x00, 0x01, 0x09, 0x20), BLE_CLASS_PHONE},
+    {"Tile tag", ADV(0x02, 0x01, 0x06, 0x03, 0x03, 0xed, 0xfe),
+     BLE_CLASS_BEACON},
+    {"phone by appearance", ADV(0x02, 0x01, 0x06, 0x03, 0x19, 0x40, 0x00),
+     BLE_CLASS_PHONE},
+    {"fast pair headphones",
+     ADV(0x02, 0x01, 0x06, 0x03, 0x03, 0x2c, 0xfe), BLE_CLASS_WEARABLE},
+    {"name only", ADV(0x02, 0x01, 0x06, 0x05, 0x09, 0x54, 0x56, 0x30, 0x31),
+     BLE_CLASS_OTHER},
+    {"padding stops parser",
+     ADV(0x02, 0x01, 0x06, 0x00, 0x0a, 0xff, 0x4c, 0x00, 0x10, 0x05, 0x0b,
+         0x1c, 0x8e, 0x2a, 0x1f),
+     BLE_CLASS_OTHER},
+    {"truncated structure",
+     ADV(0x02, 0x01, 0x06, 0x0a, 0xff, 0x4c, 0x00, 0x10, 0x05),
+     BLE_CLASS_OTHER},
+    {"empty", ADV(0x00), BLE_CLASS_OTHER},
+};
+#define ADVERTS (sizeof(adverts) / sizeof(adverts[0]))
+#endif
+
+#ifdef COUNT_SERIES
+// synthetic count traces of COUNT_SERIES send cycles: office day with
+// morning and afternoon peak, quiet night with few devices, and random
+// counts as worst case; BLE counts are about a third of Wifi counts
+inline void make_trace(CountSample_t trace[], uint8_t kind) {
+  for (uint16_t i = 0; i < COUNT_SERIES; i++) {
+    const double hour = 24.0 * i / COUNT_SERIES;
+    double wifi;
+    switch (kind) {
+    case 0:
+      wifi = 20 + 180 * exp(-pow(hour - 10, 2) / 4) +
+             140 * exp(-pow(hour - 15, 2) / 6) + esp_random() % 15;
+      break;
+    case 1:
+      wifi = 3 + esp_random() % 4;
+      break;
+    default:
+      wifi = esp_random() & 0xFFFF;
+    }
+    trace[i].wifi = wifi;
+    trace[i].ble = kind < 2 ? wifi / 3 + esp_random() % 5 : esp_random();
+    trace[i].both = 0;
+    trace[i].flags = 0;
+  }
+}
+#endif
+
+#endif
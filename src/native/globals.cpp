@@ -0,0 +1,23 @@
+#ifdef NATIVE
+
+// Globals of the native build, on the device defined in main.cpp
+
+#include "globals.h"
+
+configData_t cfg;
+char display_line6[16], display_line7[16];
+uint8_t volatile channel = 0;
+uint16_t volatile macs_total = 0, macs_wifi = 0, macs_ble = 0,
+                  batt_voltage = 0;
+hw_timer_t *channelSwitch = NULL, *sendCycle = NULL, *homeCycle = NULL,
+           *displaytimer = NULL;
+TaskHandle_t irqHandlerTask = NULL, wifiSwitchTask = NULL;
+SemaphoreHandle_t I2Caccess, CountAccess = xSemaphoreCreateMutex();
+MacBitmap macs, blemacs;
+HyperLogLog sketch(HLL_PRECISION);
+PayloadConvert payload(PAYLOAD_BUFFER_SIZE);
+TimeChangeRule myDST = DAYLIGHT_TIME;
+TimeChangeRule mySTD = STANDARD_TIME;
+Timezone myTZ(myDST, mySTD);
+
+#endif // NATIVE
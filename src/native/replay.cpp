@@ -0,0 +1,357 @@
+#ifdef NATIVE
+
+// Replays an 802.11 capture through the Wifi sniffer callback, as the Wifi
+// driver would deliver it on the device, and checks the counter against the
+// exact number of distinct sender addresses in the capture.
+// usage: pio run -e replay && .pio/build/replay/program file.pcap [speed]
+// [hop] [filter]
+// speed 0 = as fast as possible (default), 1 = recorded speed, n = n-fold
+// hop 0 = all frames are seen (default), 1 = one radio hopping channels by
+// the channel scheduler, 2 = one radio hopping channels round robin; with
+// hopping, frames of other channels than the one listened to are lost
+// filter = Wifi filter profile, default WIFI_FILTER_PROFILE
+// Capture must be pcap (not pcapng) with radiotap (127) or plain 802.11
+// (105) link layer. Send cycles follow the capture's clock.
+
+#include "globals.h"
+#include "wifiscan.h"
+#include "macqueue.h"
+#include "configmanager.h"
+#include "senddata.h"
+#include "native/fixtures.h"
+
+#include <chrono>
+#include <set>
+#include <thread>
+
+#define PCAP_MAGIC 0xa1b2c3d4    // timestamps in microseconds
+#define PCAP_MAGIC_NS 0xa1b23c4d // timestamps in nanoseconds
+#define LINKTYPE_IEEE802_11 105
+#define LINKTYPE_RADIOTAP 127
+#define REPLAY_RSSI_DEFAULT -60 // used if capture has no signal level
+#define REPLAY_SNAPLEN 4096     // max. frame size we replay
+
+typedef std::chrono::steady_clock clk;
+
+static FILE *fp;
+static bool swapped = false;
+
+static uint32_t get32(const uint8_t *p) {
+  return swapped ? (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]
+                 : (p[3] << 24) | (p[2] << 16) | (p[1] << 8) | p[0];
+}
+
+// radiotap fields are always little endian
+static uint16_t le16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static uint32_t le32(const uint8_t *p) { return le16(p) | (le16(p + 2) << 16); }
+
+static uint8_t freq2channel(uint16_t freq) {
+  if (freq == 2484)
+    return 14;
+  if (freq >= 2412 && freq <= 2472)
+    return (freq - 2407) / 5;
+  return 0; // not 2.4GHz, does not fit 4 bit channel field of ESP32
+}
+
+// parse radiotap header, returns its length or 0 if malformed; we need
+// fields 0 (TSFT) .. 5 (dBm antenna signal) of the first present word only
+static uint16_t radiotap(const uint8_t *p, uint32_t len, int8_t *rssi,
+                         uint8_t *chan, bool *fcs) {
+  // field alignment and size of bits 0..5
+  static const uint8_t align[] = {8, 1, 1, 2, 1, 1};
+  static const uint8_t size[] = {8, 1, 1, 4, 2, 1};
+
+  if (len < 8)
+    return 0;
+  const uint16_t hlen = le16(p + 2);
+  if (hlen > len)
+    return 0;
+
+  const uint32_t present = le32(p + 4);
+  uint16_t off = 8;
+  // skip extended present words
+  for (uint32_t w = present; (w & 0x80000000) && (off + 4 <= hlen);
+       w = le32(p + off - 4))
+    off += 4;
+
+  for (uint8_t bit = 0; bit < sizeof(size); bit++) {
+    if (!(present & (1 << bit)))
+      continue;
+    off = (off + align[bit] - 1) & ~(align[bit] - 1);
+    if (off + size[bit] > hlen)
+      return 0;
+    switch (bit) {
+    case 1:
+      *fcs = p[off] & 0x10;
+      break;
+    case 3:
+      *chan = freq2channel(le16(p + off));
+      break;
+    case 5:
+      *rssi = (int8_t)p[off];
+      break;
+    }
+    off += size[bit];
+  }
+  return hlen;
+}
+
+int main(int argc, char *argv[]) {
+  uint8_t hdr[24], rec[16];
+  uint8_t frame[REPLAY_SNAPLEN];
+  // frame as handed over by ESP32 Wifi driver: rx_ctrl header + 802.11 frame
+  static uint32_t pktbuf[(sizeof(wifi_pkt_rx_ctrl_t) + REPLAY_SNAPLEN) / 4 + 1];
+  wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)pktbuf;
+  uint8_t *ieee80211 = (uint8_t *)pktbuf + sizeof(wifi_pkt_rx_ctrl_t);
+  std::set<uint64_t> cycle_macs, all_macs, prev_macs;
+  uint32_t frames = 0, heard = 0, skipped = 0, offchannel = 0,
+           cycle_frames = 0, cycles = 0;
+  static const char *classes[WIFI_FRAME_CLASSES] = {
+      "probe request", "assoc request", "data to AP", "other mgmt",
+      "from AP",       "other data",    "control",    "group sender"};
+  double t_parse = 0, t_handler = 0, t_count = 0, t_send = 0;
+  clk::time_point t0, t1;
+
+  if (argc < 2) {
+    printf("usage: %s file.pcap [speed] [hop] [filter]\n", argv[0]);
+    return 1;
+  }
+  const double speed = argc > 2 ? atof(argv[2]) : 0;
+  const uint8_t hop = argc > 3 ? atoi(argv[3]) : 0;
+
+  fp = fopen(argv[1], "rb");
+  if (!fp || fread(hdr, 1, sizeof(hdr), fp) != sizeof(hdr)) {
+    printf("cannot read %s\n", argv[1]);
+    return 1;
+  }
+  uint32_t magic = get32(hdr);
+  if (magic != PCAP_MAGIC && magic != PCAP_MAGIC_NS) {
+    swapped = true;
+    magic = get32(hdr);
+  }
+  if (magic != PCAP_MAGIC && magic != PCAP_MAGIC_NS) {
+    printf("%s is not a pcap file\n", argv[1]);
+    return 1;
+  }
+  const uint32_t tsdiv = (magic == PCAP_MAGIC_NS) ? 1000 : 1;
+  const uint32_t linktype = get32(hdr + 20);
+  if (linktype != LINKTYPE_RADIOTAP && linktype != LINKTYPE_IEEE802_11) {
+    printf("unsupported link type %u\n", linktype);
+    return 1;
+  }
+
+  // same startup sequence as setup() in main.cpp, as far as it applies;
+  // no macloop task, rings are drained here to keep the run deterministic
+  loadConfig();
+  get_salt();
+#ifdef COUNT_WINDOWS
+  window_init();
+#endif
+#ifdef DWELL_ENTRIES
+  dwell_init();
+#endif
+#ifdef COUNT_BANDS
+  bands_init();
+#endif
+  beacon_init();
+  wifi_sniffer_init();
+  if (hop == 2)
+    channelsched.setRevisit(0);
+  channel = channelsched.getChannel();
+  if (argc > 4)
+    wifi_filter_set(atoi(argv[4]) <= WIFI_FILTER_PROBES ? atoi(argv[4]) : 0);
+
+  printf("Paxcounter %s replay of %s, link type %u, speed %g, hop %u, "
+         "filter %u\n",
+         PROGVERSION, argv[1], linktype, speed, hop, cfg.wififilter);
+
+  const uint64_t cycle_us = cfg.sendcycle * 2 * 1000000ULL;
+  const uint64_t hop_us = cfg.wifichancycle * 10000ULL;
+  uint64_t first_us = 0, next_send = 0, next_hop = 0;
+  const clk::time_point start = clk::now();
+
+  while (fread(rec, 1, sizeof(rec), fp) == sizeof(rec)) {
+    t0 = clk::now();
+    const uint64_t ts_us = get32(rec) * 1000000ULL + get32(rec + 4) / tsdiv;
+    const uint32_t caplen = get32(rec + 8);
+    if (caplen > sizeof(frame)) {
+      fseek(fp, caplen, SEEK_CUR);
+      skipped++;
+      continue;
+    }
+    if (fread(frame, 1, caplen, fp) != caplen)
+      break;
+
+    if (!frames++) {
+      first_us = ts_us;
+      next_send = ts_us + cycle_us;
+      next_hop = ts_us + hop_us;
+    }
+
+    // channel switches follow capture time, macloop task would have
+    // processed all frames of the slot by then
+    while (hop && (ts_us >= next_hop)) {
+      while (mac_queue_process())
+        ;
+      channel_switch();
+      next_hop += hop_us;
+    }
+
+    // send cycles follow capture time
+    while (ts_us >= next_send) {
+      t1 = clk::now();
+      t_parse += std::chrono::duration<double>(t1 - t0).count();
+      while (mac_queue_process())
+        ;
+      printf("cycle %4u: %7u frames, %6u distinct senders, %6u counted\n",
+             ++cycles, cycle_frames, (uint32_t)cycle_macs.size(), macs_wifi);
+#ifdef COUNT_BANDS
+      printf("%48u near, %6u mid, %6u far\n",
+             rssibands.getCount(RSSI_BAND_NEAR),
+             rssibands.getCount(RSSI_BAND_MID),
+             rssibands.getCount(RSSI_BAND_FAR));
+#endif
+#ifdef COUNT_VISITS
+      uint16_t newpax, back, departed;
+      uint32_t stayed = 0;
+      visits_get(&newpax, &back, &departed);
+      for (auto mac : cycle_macs)
+        stayed += prev_macs.count(mac);
+      printf("%48u new, %6u returning, %6u departed, %6u senders stayed\n",
+             newpax, back, departed, stayed);
+#endif
+      sendCounter();
+      prev_macs.swap(cycle_macs);
+      cycle_macs.clear();
+      cycle_frames = 0;
+      next_send += cycle_us;
+      t0 = clk::now();
+      t_send += std::chrono::duration<double>(t0 - t1).count();
+    }
+    cycle_frames++;
+
+    // pace replay, waiting is not accounted to any stage
+    if (speed > 0) {
+      t_parse += std::chrono::duration<double>(clk::now() - t0).count();
+      std::this_thread::sleep_until(
+          start + std::chrono::microseconds(
+                      (uint64_t)((ts_us - first_us) / speed)));
+      t0 = clk::now();
+    }
+
+    int8_t rssi = REPLAY_RSSI_DEFAULT;
+    uint8_t chan = 0;
+    bool fcs = false;
+    uint32_t off = 0;
+    if (linktype == LINKTYPE_RADIOTAP) {
+      off = radiotap(frame, caplen, &rssi, &chan, &fcs);
+      if (!off) {
+        skipped++;
+        continue;
+      }
+    }
+    uint32_t len = caplen - off;
+    if (fcs && len >= 4)
+      len -= 4;
+    if (len < 2) {
+      skipped++;
+      continue;
+    }
+
+    // build frame as the Wifi driver does; pad short frames to full
+    // header, since handler reads addr2 of any frame type
+    memset(&ppkt->rx_ctrl, 0, sizeof(ppkt->rx_ctrl));
+    ppkt->rx_ctrl.rssi = rssi;
+    ppkt->rx_ctrl.channel = chan;
+    ppkt->rx_ctrl.sig_len = len + 4; // driver counts checksum
+    memcpy(ieee80211, frame + off, len);
+    memset(ieee80211 + len, 0, len < 24 ? 28 - len : 4);
+    const uint8_t type = (frame[off] >> 2) & 3;
+
+    // control frames have no reliable sender address
+    if ((type != WIFI_PKT_CTRL) &&
+        (!cfg.rssilimit || rssi >= cfg.rssilimit)) {
+      uint64_t mac = 0;
+      for (uint8_t i = 0; i < 6; i++)
+        mac = (mac << 8) | ieee80211[10 + i]; // addr2
+      cycle_macs.insert(mac);
+      all_macs.insert(mac);
+    }
+
+    // a hopping radio misses frames on other channels
+    if (hop && chan && (chan != channel)) {
+      offchannel++;
+      t_parse += std::chrono::duration<double>(clk::now() - t0).count();
+      continue;
+    }
+
+    t1 = clk::now();
+    t_parse += std::chrono::duration<double>(t1 - t0).count();
+    wifi_sniffer_packet_handler(ppkt, (wifi_promiscuous_pkt_type_t)type);
+    t0 = clk::now();
+    t_handler += std::chrono::duration<double>(t0 - t1).count();
+
+    // drain rings before they overflow, as macloop task would
+    if ((++heard % (MAC_QUEUE_SIZE / 2)) == 0) {
+      while (mac_queue_process())
+        ;
+      t_count += std::chrono::duration<double>(clk::now() - t0).count();
+    }
+  }
+  fclose(fp);
+
+  t0 = clk::now();
+  while (mac_queue_process())
+    ;
+  t_count += std::chrono::duration<double>(clk::now() - t0).count();
+  printf("cycle %4u: %7u frames, %6u distinct senders, %6u counted "
+         "(incomplete)\n",
+         ++cycles, cycle_frames, (uint32_t)cycle_macs.size(), macs_wifi);
+
+  const double total =
+      std::chrono::duration<double>(clk::now() - start).count();
+  const uint32_t n = frames ? frames : 1;
+  printf("%u frames, %u skipped, %u distinct senders\n", frames, skipped,
+         (uint32_t)all_macs.size());
+  uint32_t passed = 0, seen = 0;
+  for (uint8_t i = 0; i < WIFI_FRAME_CLASSES; i++) {
+    const bool counted = wifi_filter_passes(i);
+    seen += wifi_frames(i);
+    passed += counted ? wifi_frames(i) : 0;
+    printf("%-14s %9u frames%s\n", classes[i], wifi_frames(i),
+           counted ? "" : ", dropped by filter");
+  }
+  printf("%u of %u frames passed filter to counter (%.1f%%)\n", passed, seen,
+         seen ? passed * 100.0 / seen : 0);
+#ifdef PROBE_FINGERPRINT
+  printf("%u probes with randomized MAC, %u merged into clusters\n",
+         mac_queue_probes(), mac_queue_merged());
+#endif
+  printf("%u missed while on other channel, %u dropped by ring\n",
+         offchannel, mac_queue_dropped(MAC_SNIFF_WIFI));
+  printf("%u messages with %u bytes sent\n", native_messages, native_bytes);
+  perfStatus_t perf;
+  perf_update();
+  perf_get(&perf);
+  printf("%u records counted, %u ns per record, max. %u us per batch, %u "
+         "vendor filtered, %u hash collisions in last cycle\n",
+         perf_counters[PERF_RECORDS].load(), perf.insertns, perf.batchmaxus,
+         perf_counters[PERF_VENDOR_DROPPED].load(), perf.collisions);
+  if (hop) {
+    uint16_t yield[CHANNEL_MAX];
+    uint8_t share[CHANNEL_MAX];
+    const uint8_t n = channel_stats(yield, share);
+    for (uint8_t i = 0; i < n; i++)
+      printf("channel %2u: %5u new devices/min, %3u%% of time\n",
+             WIFI_CHANNEL_MIN + i, yield[i], share[i]);
+  }
+  printf("%.3f s, %.0f frames/s\n", total, frames / total);
+  printf("%-10s %9.1f ns/frame\n", "parse", t_parse * 1e9 / n);
+  printf("%-10s %9.1f ns/frame\n", "handler", t_handler * 1e9 / n);
+  printf("%-10s %9.1f ns/frame\n", "count", t_count * 1e9 / n);
+  printf("%-10s %9.1f ns/frame\n", "send", t_send * 1e9 / n);
+
+  return 0;
+}
+
+#endif // NATIVE
@@ -0,0 +1,40 @@
+#ifdef NATIVE
+
+// Stand-ins for LoRa and SPI functions of the native build, which has
+// no radio. Sent messages are counted instead of being transmitted.
+
+#include "globals.h"
+#include "lorawan.h"
+#include "spislave.h"
+
+uint32_t native_messages = 0, native_bytes = 0;
+uint8_t native_maxpayload = PAYLOAD_BUFFER_SIZE; // as by datarate
+bool native_busy = false; // as by join state and send queue
+void (*native_sent)(const MessageBuffer_t *message) = NULL;
+
+void lora_enqueuedata(MessageBuffer_t *message) {
+  native_messages++;
+  native_bytes += message->MessageSize;
+  if (native_sent)
+    native_sent(message);
+}
+
+void lora_queuereset(void) {}
+
+uint8_t lora_queuewaiting(void) { return 0; }
+
+const SendStats_t *lora_sendstats(uint8_t cls) { return NULL; }
+
+uint8_t lora_maxpayload(void) { return native_maxpayload; }
+
+bool lora_busy(void) { return native_busy; }
+
+void lora_housekeeping(void) {}
+
+void spi_enqueuedata(MessageBuffer_t *message) {}
+
+void spi_queuereset(void) {}
+
+void spi_housekeeping(void) {}
+
+#endif // NATIVE
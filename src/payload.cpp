@@ -1,9 +1,14 @@
 #include "globals.h"
 #include "payload.h"
 
+// Local logging tag
+static const char TAG[] = "main";
+
 PayloadConvert::PayloadConvert(uint8_t size) {
   buffer = (uint8_t *)malloc(size);
+  maxsize = buffer ? size : 0;
   cursor = 0;
+  format = PAYLOAD_ENCODER;
 }
 
 PayloadConvert::~PayloadConvert(void) { free(buffer); }
@@ -14,428 +19,640 @@ uint8_t PayloadConvert::getSize(void) { return cursor; }
 
 uint8_t *PayloadConvert::getBuffer(void) { return buffer; }
 
-/* ---------------- plain format without special encoding ---------- */
+bool PayloadConvert::setFormat(uint8_t value) {
+  if (value < PAYLOAD_PLAIN || value > PAYLOAD_LPP_PACKED)
+    return false;
+  format = value;
+  cursor = 0; // records of different formats must not be mixed
+  return true;
+}
+
+uint8_t PayloadConvert::getFormat(void) const { return format; }
+
+const char *PayloadConvert::getFormatName(void) const {
+  switch (format) {
+  case PAYLOAD_PLAIN:
+    return "PLAIN";
+  case PAYLOAD_PACKED:
+    return "PACKED";
+  case PAYLOAD_LPP_DYNAMIC:
+    return "LPPDYN";
+  default:
+    return "LPPPKD";
+  }
+}
 
-#if PAYLOAD_ENCODER == 1
+// plain and packed format send each record type on its own port, Cayenne
+// LPP sends all records on one port
+bool PayloadConvert::hasPorts(void) const {
+  return (format == PAYLOAD_PLAIN) || (format == PAYLOAD_PACKED);
+}
 
-void PayloadConvert::addCount(uint16_t value, uint8_t snifftype) {
-  buffer[cursor++] = highByte(value);
-  buffer[cursor++] = lowByte(value);
+bool PayloadConvert::refuse(uint16_t n) {
+  ESP_LOGE(TAG, "Payload record of %d bytes does not fit, %d of %d used", n,
+           cursor, maxsize);
+  return false;
 }
 
-void PayloadConvert::addAlarm(int8_t rssi, uint8_t msg) {
-  buffer[cursor++] = rssi;
-  buffer[cursor++] = msg;
+// writers advance cursor before storing, since stores through a byte
+// pointer may alias cursor and would force a reload for every byte
+
+void PayloadConvert::writeBytes(const void *data, uint8_t n) {
+  uint8_t *p = buffer + cursor;
+  cursor += n;
+  memcpy(p, data, n);
 }
 
-void PayloadConvert::addVoltage(uint16_t value) {
-  buffer[cursor++] = highByte(value);
-  buffer[cursor++] = lowByte(value);
+void PayloadConvert::writeBE(uint32_t value, uint8_t bytes) {
+  uint8_t *p = buffer + cursor;
+  cursor += bytes;
+  while (bytes--)
+    *p++ = (uint8_t)(value >> (bytes * 8));
 }
 
-void PayloadConvert::addConfig(configData_t value) {
-  buffer[cursor++] = value.lorasf;
-  buffer[cursor++] = value.txpower;
-  buffer[cursor++] = value.adrmode;
-  buffer[cursor++] = value.screensaver;
-  buffer[cursor++] = value.screenon;
-  buffer[cursor++] = value.countermode;
-  buffer[cursor++] = highByte(value.rssilimit);
-  buffer[cursor++] = lowByte(value.rssilimit);
-  buffer[cursor++] = value.sendcycle;
-  buffer[cursor++] = value.wifichancycle;
-  buffer[cursor++] = value.blescantime;
-  buffer[cursor++] = value.blescan;
-  buffer[cursor++] = value.wifiant;
-  buffer[cursor++] = value.vendorfilter;
-  buffer[cursor++] = value.rgblum;
-  buffer[cursor++] = value.payloadmask;
-  buffer[cursor++] = value.monitormode;
-  memcpy(buffer + cursor, value.version, 10);
-  cursor += 10;
+void PayloadConvert::writeLE(uint32_t value, uint8_t bytes) {
+  uint8_t *p = buffer + cursor;
+  cursor += bytes;
+  for (uint8_t x = 0; x < bytes; x++)
+    p[x] = (uint8_t)(value >> (x * 8));
 }
 
-void PayloadConvert::addStatus(uint16_t voltage, uint64_t uptime, float cputemp,
-                               uint32_t mem, uint8_t reset1, uint8_t reset2) {
+/* ---------------- plain format without special encoding ---------- */
 
-  buffer[cursor++] = highByte(voltage);
-  buffer[cursor++] = lowByte(voltage);
-  buffer[cursor++] = (byte)((uptime & 0xFF00000000000000) >> 56);
-  buffer[cursor++] = (byte)((uptime & 0x00FF000000000000) >> 48);
-  buffer[cursor++] = (byte)((uptime & 0x0000FF0000000000) >> 40);
-  buffer[cursor++] = (byte)((uptime & 0x000000FF00000000) >> 32);
-  buffer[cursor++] = (byte)((uptime & 0x00000000FF000000) >> 24);
-  buffer[cursor++] = (byte)((uptime & 0x0000000000FF0000) >> 16);
-  buffer[cursor++] = (byte)((uptime & 0x000000000000FF00) >> 8);
-  buffer[cursor++] = (byte)((uptime & 0x00000000000000FF));
-  buffer[cursor++] = (byte)(cputemp);
-  buffer[cursor++] = (byte)((mem & 0xFF000000) >> 24);
-  buffer[cursor++] = (byte)((mem & 0x00FF0000) >> 16);
-  buffer[cursor++] = (byte)((mem & 0x0000FF00) >> 8);
-  buffer[cursor++] = (byte)((mem & 0x000000FF));
-  buffer[cursor++] = (byte)(reset1);
-  buffer[cursor++] = (byte)(reset2);
-}
+struct PlainFormat {
+
+  // record sizes [bytes]
+  enum {
+    COUNT = 2,
+    FLAGS = 1,
+    ALARM = 2,
+    VOLTAGE = 2,
+    CONFIG = 17 + 10,
+    STATUS = 17,
+    GPS = 13,
+    BME = 8,
+    BUTTON = 1,
+    SKETCH = 2, // plus 1 byte per register
+    SKETCH_REG = 1,
+    WINDOW = 3,
+    DWELL = 2,
+    CHANNEL = 3,
+    BAND = 2,
+    VISITS = 6,
+    PERF = 16
+  };
+
+  static void count(PayloadConvert &p, uint16_t value, uint8_t snifftype) {
+    p.writeBE(value, 2);
+  }
 
-void PayloadConvert::addGPS(gpsStatus_t value) {
-#ifdef HAS_GPS
-  buffer[cursor++] = (byte)((value.latitude & 0xFF000000) >> 24);
-  buffer[cursor++] = (byte)((value.latitude & 0x00FF0000) >> 16);
-  buffer[cursor++] = (byte)((value.latitude & 0x0000FF00) >> 8);
-  buffer[cursor++] = (byte)((value.latitude & 0x000000FF));
-  buffer[cursor++] = (byte)((value.longitude & 0xFF000000) >> 24);
-  buffer[cursor++] = (byte)((value.longitude & 0x00FF0000) >> 16);
-  buffer[cursor++] = (byte)((value.longitude & 0x0000FF00) >> 8);
-  buffer[cursor++] = (byte)((value.longitude & 0x000000FF));
-  buffer[cursor++] = value.satellites;
-  buffer[cursor++] = highByte(value.hdop);
-  buffer[cursor++] = lowByte(value.hdop);
-  buffer[cursor++] = highByte(value.altitude);
-  buffer[cursor++] = lowByte(value.altitude);
-#endif
-}
+  static void flags(PayloadConvert &p, uint8_t flags) { p.writeByte(flags); }
 
-void PayloadConvert::addSensor(uint8_t buf[]) {
-#ifdef HAS_SENSORS
-  uint8_t length = buf[0];
-  memcpy(buffer, buf + 1, length);
-  cursor += length; // length of buffer
-#endif
-}
+  static void alarm(PayloadConvert &p, int8_t rssi, uint8_t msg) {
+    p.writeByte(rssi);
+    p.writeByte(msg);
+  }
 
-void PayloadConvert::addBME(bmeStatus_t value) {
-#ifdef HAS_BME
-  int16_t temperature = (int16_t)(value.temperature); // float -> int
-  uint16_t humidity = (uint16_t)(value.humidity);     // float -> int
-  uint16_t pressure = (uint16_t)(value.pressure);     // float -> int
-  uint16_t iaq = (uint16_t)(value.iaq);               // float -> int
-  buffer[cursor++] = highByte(temperature);
-  buffer[cursor++] = lowByte(temperature);
-  buffer[cursor++] = highByte(pressure);
-  buffer[cursor++] = lowByte(pressure);
-  buffer[cursor++] = highByte(humidity);
-  buffer[cursor++] = lowByte(humidity);
-  buffer[cursor++] = highByte(iaq);
-  buffer[cursor++] = lowByte(iaq);
-#endif
-}
+  static void voltage(PayloadConvert &p, uint16_t value) {
+    p.writeBE(value, 2);
+  }
 
-void PayloadConvert::addButton(uint8_t value) {
-#ifdef HAS_BUTTON
-  buffer[cursor++] = value;
-#endif
-}
+  static void config(PayloadConvert &p, const configData_t &value) {
+    p.writeByte(value.lorasf);
+    p.writeByte(value.txpower);
+    p.writeByte(value.adrmode);
+    p.writeByte(value.screensaver);
+    p.writeByte(value.screenon);
+    p.writeByte(value.countermode);
+    p.writeBE(value.rssilimit, 2);
+    p.writeByte(value.sendcycle);
+    p.writeByte(value.wifichancycle);
+    p.writeByte(value.blescantime);
+    p.writeByte(value.blescan);
+    p.writeByte(value.wifiant);
+    p.writeByte(value.vendorfilter);
+    p.writeByte(value.rgblum);
+    p.writeByte(value.payloadmask);
+    p.writeByte(value.monitormode);
+    p.writeBytes(value.version, 10);
+  }
+
+  static void status(PayloadConvert &p, uint16_t voltage, uint64_t uptime,
+                     float cputemp, uint32_t mem, uint8_t reset1,
+                     uint8_t reset2) {
+    p.writeBE(voltage, 2);
+    p.writeBE(uptime >> 32, 4);
+    p.writeBE(uptime, 4);
+    p.writeByte((byte)cputemp);
+    p.writeBE(mem, 4);
+    p.writeByte(reset1);
+    p.writeByte(reset2);
+  }
+
+  static void gps(PayloadConvert &p, const gpsStatus_t &value) {
+    p.writeBE((uint32_t)value.latitude, 4);
+    p.writeBE((uint32_t)value.longitude, 4);
+    p.writeByte(value.satellites);
+    p.writeBE(value.hdop, 2);
+    p.writeBE((uint16_t)value.altitude, 2);
+  }
+
+  static void bme(PayloadConvert &p, const bmeStatus_t &value) {
+    p.writeBE((uint16_t)(int16_t)value.temperature, 2); // float -> int
+    p.writeBE((uint16_t)value.pressure, 2);
+    p.writeBE((uint16_t)value.humidity, 2);
+    p.writeBE((uint16_t)value.iaq, 2);
+  }
+
+  static void button(PayloadConvert &p, uint8_t value) { p.writeByte(value); }
+
+  static void sketch(PayloadConvert &p, uint8_t precision, uint8_t offset,
+                     const uint8_t regs[], uint8_t count) {
+    p.writeByte(precision);
+    p.writeByte(offset);
+    p.writeBytes(regs, count);
+  }
+
+  static void windows(PayloadConvert &p, const uint8_t windows[],
+                      const uint16_t counts[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+      p.writeByte(windows[i]);
+      p.writeBE(counts[i], 2);
+    }
+  }
+
+  static void dwell(PayloadConvert &p, const uint16_t bins[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++)
+      p.writeBE(bins[i], 2);
+  }
+
+  static void channels(PayloadConvert &p, const uint16_t yield[],
+                       const uint8_t share[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+      p.writeBE(yield[i], 2);
+      p.writeByte(share[i]);
+    }
+  }
+
+  static void bands(PayloadConvert &p, const uint16_t counts[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++)
+      p.writeBE(counts[i], 2);
+  }
+
+  static void visits(PayloadConvert &p, const uint16_t counts[]) {
+    bands(p, counts, 3);
+  }
+
+  static void perf(PayloadConvert &p, const uint16_t counts[]) {
+    bands(p, counts, 8);
+  }
+};
 
 /* ---------------- packed format with LoRa serialization Encoder ----------
  */
 // derived from
 // https://github.com/thesolarnomad/lora-serialization/blob/master/src/LoraEncoder.cpp
 
-#elif PAYLOAD_ENCODER == 2
-
-void PayloadConvert::addCount(uint16_t value, uint8_t snifftype) { writeUint16(value); }
-
-void PayloadConvert::addAlarm(int8_t rssi, uint8_t msg) {
-  writeUint8(rssi);
-  writeUint8(msg);
-}
+struct PackedFormat {
+
+  // record sizes [bytes]
+  enum {
+    COUNT = 2,
+    FLAGS = 1,
+    ALARM = 2,
+    VOLTAGE = 2,
+    CONFIG = 10 + 10,
+    STATUS = 17,
+    GPS = 13,
+    BME = 8,
+    BUTTON = 1,
+    SKETCH = 2, // plus 1 byte per register
+    SKETCH_REG = 1,
+    WINDOW = 3,
+    DWELL = 2,
+    CHANNEL = 3,
+    BAND = 2,
+    VISITS = 6,
+    PERF = 16
+  };
+
+  static void count(PayloadConvert &p, uint16_t value, uint8_t snifftype) {
+    p.writeLE(value, 2);
+  }
 
-void PayloadConvert::addVoltage(uint16_t value) { writeUint16(value); }
-
-void PayloadConvert::addConfig(configData_t value) {
-  writeUint8(value.lorasf);
-  writeUint8(value.txpower);
-  writeUint16(value.rssilimit);
-  writeUint8(value.sendcycle);
-  writeUint8(value.wifichancycle);
-  writeUint8(value.blescantime);
-  writeUint8(value.rgblum);
-  writeBitmap(value.adrmode ? true : false, value.screensaver ? true : false,
-              value.screenon ? true : false, value.countermode ? true : false,
-              value.blescan ? true : false, value.wifiant ? true : false,
-              value.vendorfilter ? true : false,
-              value.monitormode ? true : false);
-  writeBitmap(value.payloadmask && GPS_DATA ? true : false,
-              value.payloadmask && ALARM_DATA ? true : false,
-              value.payloadmask && MEMS_DATA ? true : false,
-              value.payloadmask && COUNT_DATA ? true : false,
-              value.payloadmask && SENSOR1_DATA ? true : false,
-              value.payloadmask && SENSOR2_DATA ? true : false,
-              value.payloadmask && SENSOR3_DATA ? true : false,
-              value.payloadmask && BATT_DATA ? true : false);
-  writeVersion(value.version);
-}
+  static void flags(PayloadConvert &p, uint8_t flags) { p.writeByte(flags); }
 
-void PayloadConvert::addStatus(uint16_t voltage, uint64_t uptime, float cputemp,
-                               uint32_t mem, uint8_t reset1, uint8_t reset2) {
-  writeUint16(voltage);
-  writeUptime(uptime);
-  writeUint8((byte)cputemp);
-  writeUint32(mem);
-  writeUint8(reset1);
-  writeUint8(reset2);
-}
+  static void alarm(PayloadConvert &p, int8_t rssi, uint8_t msg) {
+    p.writeByte(rssi);
+    p.writeByte(msg);
+  }
 
-void PayloadConvert::addGPS(gpsStatus_t value) {
-#ifdef HAS_GPS
-  writeLatLng(value.latitude, value.longitude);
-  writeUint8(value.satellites);
-  writeUint16(value.hdop);
-  writeUint16(value.altitude);
-#endif
-}
+  static void voltage(PayloadConvert &p, uint16_t value) {
+    p.writeLE(value, 2);
+  }
 
-void PayloadConvert::addSensor(uint8_t buf[]) {
-#ifdef HAS_SENSORS
-  uint8_t length = buf[0];
-  memcpy(buffer, buf + 1, length);
-  cursor += length; // length of buffer
-#endif
-}
+  static void bitmap(PayloadConvert &p, bool a, bool b, bool c, bool d, bool e,
+                     bool f, bool g, bool h) {
+    // first flag is MSB
+    p.writeByte(a << 7 | b << 6 | c << 5 | d << 4 | e << 3 | f << 2 | g << 1 |
+                h);
+  }
 
-void PayloadConvert::addBME(bmeStatus_t value) {
-#ifdef HAS_BME
-  writeFloat(value.temperature);
-  writePressure(value.pressure);
-  writeUFloat(value.humidity);
-  writeUFloat(value.iaq);
-#endif
-}
+  static void config(PayloadConvert &p, const configData_t &value) {
+    p.writeByte(value.lorasf);
+    p.writeByte(value.txpower);
+    p.writeLE(value.rssilimit, 2);
+    p.writeByte(value.sendcycle);
+    p.writeByte(value.wifichancycle);
+    p.writeByte(value.blescantime);
+    p.writeByte(value.rgblum);
+    bitmap(p, value.adrmode, value.screensaver, value.screenon,
+           value.countermode, value.blescan, value.wifiant,
+           value.vendorfilter, value.monitormode);
+    bitmap(p, value.payloadmask & GPS_DATA, value.payloadmask & ALARM_DATA,
+           value.payloadmask & MEMS_DATA, value.payloadmask & COUNT_DATA,
+           value.payloadmask & SENSOR1_DATA, value.payloadmask & SENSOR2_DATA,
+           value.payloadmask & SENSOR3_DATA, value.payloadmask & BATT_DATA);
+    p.writeBytes(value.version, 10);
+  }
 
-void PayloadConvert::addButton(uint8_t value) {
-#ifdef HAS_BUTTON
-  writeUint8(value);
-#endif
-}
+  static void status(PayloadConvert &p, uint16_t voltage, uint64_t uptime,
+                     float cputemp, uint32_t mem, uint8_t reset1,
+                     uint8_t reset2) {
+    p.writeLE(voltage, 2);
+    p.writeLE(uptime, 4);
+    p.writeLE(uptime >> 32, 4);
+    p.writeByte((byte)cputemp);
+    p.writeLE(mem, 4);
+    p.writeByte(reset1);
+    p.writeByte(reset2);
+  }
 
-void PayloadConvert::intToBytes(uint8_t pos, int32_t i, uint8_t byteSize) {
-  for (uint8_t x = 0; x < byteSize; x++) {
-    buffer[x + pos] = (byte)(i >> (x * 8));
+  static void gps(PayloadConvert &p, const gpsStatus_t &value) {
+    p.writeLE((uint32_t)value.latitude, 4);
+    p.writeLE((uint32_t)value.longitude, 4);
+    p.writeByte(value.satellites);
+    p.writeLE(value.hdop, 2);
+    p.writeLE((uint16_t)value.altitude, 2);
   }
-  cursor += byteSize;
-}
 
-void PayloadConvert::writeUptime(uint64_t uptime) {
-  intToBytes(cursor, uptime, 8);
-}
+  // uses a 16bit two's complement with two decimals, so the range is
+  // -327.68 to +327.67 degrees
+  static void temperature(PayloadConvert &p, float value) {
+    p.writeBE((uint16_t)(int16_t)(value * 100), 2);
+  }
 
-void PayloadConvert::writeVersion(char *version) {
-  memcpy(buffer + cursor, version, 10);
-  cursor += 10;
-}
+  static void bme(PayloadConvert &p, const bmeStatus_t &value) {
+    temperature(p, value.temperature);
+    p.writeLE((uint16_t)(int16_t)value.pressure, 2);
+    p.writeLE((uint16_t)(int16_t)(value.humidity * 100), 2);
+    p.writeLE((uint16_t)(int16_t)(value.iaq * 100), 2);
+  }
 
-void PayloadConvert::writeLatLng(double latitude, double longitude) {
-  intToBytes(cursor, latitude, 4);
-  intToBytes(cursor, longitude, 4);
-}
+  static void button(PayloadConvert &p, uint8_t value) { p.writeByte(value); }
 
-void PayloadConvert::writeUint32(uint32_t i) { intToBytes(cursor, i, 4); }
+  static void sketch(PayloadConvert &p, uint8_t precision, uint8_t offset,
+                     const uint8_t regs[], uint8_t count) {
+    p.writeByte(precision);
+    p.writeByte(offset);
+    p.writeBytes(regs, count);
+  }
 
-void PayloadConvert::writeUint16(uint16_t i) { intToBytes(cursor, i, 2); }
+  static void windows(PayloadConvert &p, const uint8_t windows[],
+                      const uint16_t counts[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+      p.writeByte(windows[i]);
+      p.writeLE(counts[i], 2);
+    }
+  }
 
-void PayloadConvert::writeUint8(uint8_t i) { intToBytes(cursor, i, 1); }
+  static void dwell(PayloadConvert &p, const uint16_t bins[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++)
+      p.writeLE(bins[i], 2);
+  }
 
-void PayloadConvert::writeUFloat(float value) {
-  int16_t h = (int16_t)(value * 100);
-  intToBytes(cursor, h, 2);
-}
+  static void channels(PayloadConvert &p, const uint16_t yield[],
+                       const uint8_t share[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+      p.writeLE(yield[i], 2);
+      p.writeByte(share[i]);
+    }
+  }
 
-void PayloadConvert::writePressure(float value) {
-  int16_t h = (int16_t)(value);
-  intToBytes(cursor, h, 2);
-}
+  static void bands(PayloadConvert &p, const uint16_t counts[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++)
+      p.writeLE(counts[i], 2);
+  }
 
-/**
- * Uses a 16bit two's complement with two decimals, so the range is
- * -327.68 to +327.67 degrees
- */
-void PayloadConvert::writeFloat(float value) {
-  int16_t t = (int16_t)(value * 100);
-  if (value < 0) {
-    t = ~-t;
-    t = t + 1;
-  }
-  buffer[cursor++] = (byte)((t >> 8) & 0xFF);
-  buffer[cursor++] = (byte)t & 0xFF;
-}
+  static void visits(PayloadConvert &p, const uint16_t counts[]) {
+    bands(p, counts, 3);
+  }
 
-void PayloadConvert::writeBitmap(bool a, bool b, bool c, bool d, bool e, bool f,
-                                 bool g, bool h) {
-  uint8_t bitmap = 0;
-  // LSB first
-  bitmap |= (a & 1) << 7;
-  bitmap |= (b & 1) << 6;
-  bitmap |= (c & 1) << 5;
-  bitmap |= (d & 1) << 4;
-  bitmap |= (e & 1) << 3;
-  bitmap |= (f & 1) << 2;
-  bitmap |= (g & 1) << 1;
-  bitmap |= (h & 1) << 0;
-  writeUint8(bitmap);
-}
+  static void perf(PayloadConvert &p, const uint16_t counts[]) {
+    bands(p, counts, 8);
+  }
+};
 
 /* ---------------- Cayenne LPP 2.0 format ---------- */
 // see specs http://community.mydevices.com/t/cayenne-lpp-2-0/7510
-// PAYLOAD_ENCODER == 3 -> Dynamic Sensor Payload, using channels -> FPort 1
-// PAYLOAD_ENCODER == 4 -> Packed Sensor Payload, not using channels -> FPort 2
+// Dynamic = true -> Dynamic Sensor Payload, using channels -> FPort 1
+// Dynamic = false -> Packed Sensor Payload, not using channels -> FPort 2
+// Cayenne has no data type meter, so counts are sent as luminosity
 
-#elif (PAYLOAD_ENCODER == 3 || PAYLOAD_ENCODER == 4)
+template <bool Dynamic> struct LppFormat {
 
-void PayloadConvert::addCount(uint16_t value, uint8_t snifftype) {
-  switch(snifftype) {
-  case MAC_SNIFF_WIFI:
-#if (PAYLOAD_ENCODER == 3)
-    buffer[cursor++] = LPP_COUNT_WIFI_CHANNEL;
+  enum { CH = Dynamic ? 1 : 0 }; // channel byte in front of each value
+
+  // record sizes [bytes]
+  enum {
+    COUNT = CH + 3,
+    FLAGS = CH + 2,
+    ALARM = (CH + 2) + (CH + 3),
+    VOLTAGE = CH + 3,
+    CONFIG = CH + 2,
+#ifdef HAS_BATTERY_PROBE
+    STATUS = 2 * (CH + 3),
+#else
+    STATUS = CH + 3,
 #endif
-    buffer[cursor++] =
-        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
-    buffer[cursor++] = highByte(value);
-    buffer[cursor++] = lowByte(value);
-    break;
-  case MAC_SNIFF_BLE:
-#if (PAYLOAD_ENCODER == 3)
-    buffer[cursor++] = LPP_COUNT_BLE_CHANNEL;
+    GPS = CH + 10,
+    BME = 3 * (CH + 3) + CH + 2,
+    BUTTON = CH + 2,
+    SKETCH = 0, // no Cayenne LPP data type for sketch registers
+    SKETCH_REG = 0,
+    WINDOW = CH + 3,
+    DWELL = CH + 3,
+    CHANNEL = 0, // no Cayenne LPP data type for channel statistics
+    BAND = CH + 3,
+    VISITS = 3 * (CH + 3),
+    PERF = 0 // no Cayenne LPP data type for sniffer performance counters
+  };
+
+  static void value(PayloadConvert &p, uint8_t channel, uint8_t type) {
+    if (Dynamic)
+      p.writeBE(channel << 8 | type, 2);
+    else
+      p.writeByte(type);
+  }
+
+  static void count(PayloadConvert &p, uint16_t val, uint8_t snifftype) {
+    switch (snifftype) {
+    case MAC_SNIFF_WIFI:
+      value(p, LPP_COUNT_WIFI_CHANNEL, LPP_LUMINOSITY);
+      break;
+    case MAC_SNIFF_BLE:
+      value(p, LPP_COUNT_BLE_CHANNEL, LPP_LUMINOSITY);
+      break;
+    case MAC_SNIFF_BOTH:
+      value(p, LPP_COUNT_BOTH_CHANNEL, LPP_LUMINOSITY);
+      break;
+    default:
+      return;
+    }
+    p.writeBE(val, 2);
+  }
+
+  static void flags(PayloadConvert &p, uint8_t flags) {
+    value(p, LPP_COUNT_FLAGS_CHANNEL, LPP_DIGITAL_INPUT);
+    p.writeByte(flags);
+  }
+
+  static void alarm(PayloadConvert &p, int8_t rssi, uint8_t msg) {
+    value(p, LPP_ALARM_CHANNEL, LPP_PRESENCE);
+    p.writeByte(msg);
+    value(p, LPP_MSG_CHANNEL, LPP_ANALOG_INPUT); // 0.01 signed
+    p.writeBE((uint16_t)(int16_t)(rssi * 100), 2);
+  }
+
+  static void voltage(PayloadConvert &p, uint16_t val) {
+    value(p, LPP_BATT_CHANNEL, LPP_ANALOG_INPUT);
+    p.writeBE(val / 10, 2);
+  }
+
+  static void config(PayloadConvert &p, const configData_t &val) {
+    value(p, LPP_ADR_CHANNEL, LPP_DIGITAL_INPUT);
+    p.writeByte(val.adrmode);
+  }
+
+  static void status(PayloadConvert &p, uint16_t voltage, uint64_t uptime,
+                     float celsius, uint32_t mem, uint8_t reset1,
+                     uint8_t reset2) {
+#ifdef HAS_BATTERY_PROBE
+    value(p, LPP_BATT_CHANNEL, LPP_ANALOG_INPUT);
+    p.writeBE(voltage / 10, 2);
 #endif
-    buffer[cursor++] =
-        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
-    buffer[cursor++] = highByte(value);
-    buffer[cursor++] = lowByte(value);
-    break;
+    value(p, LPP_TEMPERATURE_CHANNEL, LPP_TEMPERATURE);
+    p.writeBE((uint16_t)(int16_t)(celsius * 10), 2);
+  }
+
+  static void gps(PayloadConvert &p, const gpsStatus_t &val) {
+    value(p, LPP_GPS_CHANNEL, LPP_GPS); // 3 bytes each, signed MSB
+    p.writeBE((uint32_t)(val.latitude / 100), 3);
+    p.writeBE((uint32_t)(val.longitude / 100), 3);
+    p.writeBE((uint32_t)(val.altitude * 100), 3);
+  }
+
+  static void bme(PayloadConvert &p, const bmeStatus_t &val) {
+    // data value conversions to meet cayenne data type definition
+    // 0.1°C per bit => -3276,7 .. +3276,7 °C
+    value(p, LPP_TEMPERATURE_CHANNEL, LPP_TEMPERATURE);
+    p.writeBE((uint16_t)(int16_t)(val.temperature * 10.0), 2);
+    // 0.1 hPa per bit => 0 .. 6553,6 hPa
+    value(p, LPP_BAROMETER_CHANNEL, LPP_BAROMETER);
+    p.writeBE((uint16_t)(val.pressure * 10), 2);
+    // 0.5% per bit => 0 .. 128 %C
+    value(p, LPP_HUMIDITY_CHANNEL, LPP_HUMIDITY);
+    p.writeByte((uint8_t)(val.humidity * 2.0));
+    // 1.0 unsigned
+    value(p, LPP_AIR_CHANNEL, LPP_LUMINOSITY);
+    p.writeBE((uint16_t)(int16_t)val.iaq, 2);
+  }
+
+  static void button(PayloadConvert &p, uint8_t val) {
+    value(p, LPP_BUTTON_CHANNEL, LPP_DIGITAL_INPUT);
+    p.writeByte(val);
+  }
+
+  static void sketch(PayloadConvert &p, uint8_t precision, uint8_t offset,
+                     const uint8_t regs[], uint8_t count) {}
+
+  static void series(PayloadConvert &p, uint8_t channel,
+                     const uint16_t counts[], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+      value(p, channel + i, LPP_LUMINOSITY);
+      p.writeBE(counts[i], 2);
+    }
+  }
+
+  static void windows(PayloadConvert &p, const uint8_t windows[],
+                      const uint16_t counts[], uint8_t n) {
+    series(p, LPP_WINDOW_CHANNEL, counts, n);
+  }
+
+  static void dwell(PayloadConvert &p, const uint16_t bins[], uint8_t n) {
+    series(p, LPP_DWELL_CHANNEL, bins, n);
+  }
+
+  static void channels(PayloadConvert &p, const uint16_t yield[],
+                       const uint8_t share[], uint8_t n) {}
+
+  static void bands(PayloadConvert &p, const uint16_t counts[], uint8_t n) {
+    series(p, LPP_BAND_CHANNEL, counts, n);
   }
+
+  static void visits(PayloadConvert &p, const uint16_t counts[]) {
+    series(p, LPP_VISIT_CHANNEL, counts, 3);
+  }
+
+  static void perf(PayloadConvert &p, const uint16_t counts[]) {}
+};
+
+// fixed size records must fit into an empty payload buffer
+#define PAYLOAD_CHECK_SIZES(F)                                                 \
+  static_assert(F::CONFIG <= PAYLOAD_BUFFER_SIZE &&                            \
+                    F::STATUS <= PAYLOAD_BUFFER_SIZE &&                        \
+                    F::GPS <= PAYLOAD_BUFFER_SIZE &&                           \
+                    F::BME <= PAYLOAD_BUFFER_SIZE &&                           \
+                    F::PERF <= PAYLOAD_BUFFER_SIZE,                            \
+                #F " record exceeds PAYLOAD_BUFFER_SIZE")
+
+PAYLOAD_CHECK_SIZES(PlainFormat);
+PAYLOAD_CHECK_SIZES(PackedFormat);
+PAYLOAD_CHECK_SIZES(LppFormat<true>);
+PAYLOAD_CHECK_SIZES(LppFormat<false>);
+
+/* ---------------- dispatch to selected format ---------- */
+
+// select format F once per record, then write record with size bytes by
+// F::call, or refuse it as a whole if it does not fit into the buffer
+#define PAYLOAD_RECORD(size, call)                                             \
+  switch (format) {                                                            \
+  case PAYLOAD_PLAIN: {                                                        \
+    typedef PlainFormat F;                                                     \
+    return fits(size) ? (F::call, true) : refuse(size);                        \
+  }                                                                            \
+  case PAYLOAD_PACKED: {                                                       \
+    typedef PackedFormat F;                                                    \
+    return fits(size) ? (F::call, true) : refuse(size);                        \
+  }                                                                            \
+  case PAYLOAD_LPP_DYNAMIC: {                                                  \
+    typedef LppFormat<true> F;                                                 \
+    return fits(size) ? (F::call, true) : refuse(size);                        \
+  }                                                                            \
+  default: {                                                                   \
+    typedef LppFormat<false> F;                                                \
+    return fits(size) ? (F::call, true) : refuse(size);                        \
+  }                                                                            \
+  }
+
+bool PayloadConvert::addCount(uint16_t value, uint8_t snifftype) {
+  PAYLOAD_RECORD(F::COUNT, count(*this, value, snifftype));
 }
 
-void PayloadConvert::addAlarm(int8_t rssi, uint8_t msg) {
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_ALARM_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_PRESENCE;
-  buffer[cursor++] = msg;
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_MSG_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_ANALOG_INPUT;
-  buffer[cursor++] = rssi;
+bool PayloadConvert::addCountFlags(uint8_t flags) {
+  PAYLOAD_RECORD(F::FLAGS, flags(*this, flags));
 }
 
-void PayloadConvert::addVoltage(uint16_t value) {
-  uint16_t volt = value / 10;
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_BATT_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_ANALOG_INPUT;
-  buffer[cursor++] = highByte(volt);
-  buffer[cursor++] = lowByte(volt);
+bool PayloadConvert::addAlarm(int8_t rssi, uint8_t msg) {
+  PAYLOAD_RECORD(F::ALARM, alarm(*this, rssi, msg));
 }
 
-void PayloadConvert::addConfig(configData_t value) {
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_ADR_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_DIGITAL_INPUT;
-  buffer[cursor++] = value.adrmode;
+bool PayloadConvert::addVoltage(uint16_t value) {
+  PAYLOAD_RECORD(F::VOLTAGE, voltage(*this, value));
 }
 
-void PayloadConvert::addStatus(uint16_t voltage, uint64_t uptime, float celsius,
-                               uint32_t mem, uint8_t reset1, uint8_t reset2) {
-  uint16_t temp = celsius * 10;
-  uint16_t volt = voltage / 10;
-#ifdef HAS_BATTERY_PROBE
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_BATT_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_ANALOG_INPUT;
-  buffer[cursor++] = highByte(volt);
-  buffer[cursor++] = lowByte(volt);
-#endif // HAS_BATTERY_PROBE
+bool PayloadConvert::addConfig(configData_t value) {
+  PAYLOAD_RECORD(F::CONFIG, config(*this, value));
+}
 
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_TEMPERATURE_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_TEMPERATURE;
-  buffer[cursor++] = highByte(temp);
-  buffer[cursor++] = lowByte(temp);
+bool PayloadConvert::addStatus(uint16_t voltage, uint64_t uptime, float cputemp,
+                               uint32_t mem, uint8_t reset1, uint8_t reset2) {
+  PAYLOAD_RECORD(F::STATUS,
+                 status(*this, voltage, uptime, cputemp, mem, reset1, reset2));
 }
 
-void PayloadConvert::addGPS(gpsStatus_t value) {
+bool PayloadConvert::addGPS(gpsStatus_t value) {
 #ifdef HAS_GPS
-  int32_t lat = value.latitude / 100;
-  int32_t lon = value.longitude / 100;
-  int32_t alt = value.altitude * 100;
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_GPS_CHANNEL;
+  PAYLOAD_RECORD(F::GPS, gps(*this, value));
+#else
+  return false;
 #endif
-  buffer[cursor++] = LPP_GPS;
-  buffer[cursor++] = (byte)((lat & 0xFF0000) >> 16);
-  buffer[cursor++] = (byte)((lat & 0x00FF00) >> 8);
-  buffer[cursor++] = (byte)((lat & 0x0000FF));
-  buffer[cursor++] = (byte)((lon & 0xFF0000) >> 16);
-  buffer[cursor++] = (byte)((lon & 0x00FF00) >> 8);
-  buffer[cursor++] = (byte)(lon & 0x0000FF);
-  buffer[cursor++] = (byte)((alt & 0xFF0000) >> 16);
-  buffer[cursor++] = (byte)((alt & 0x00FF00) >> 8);
-  buffer[cursor++] = (byte)(alt & 0x0000FF);
-#endif // HAS_GPS
 }
 
-void PayloadConvert::addSensor(uint8_t buf[]) {
+bool PayloadConvert::addSensor(uint8_t buf[]) {
 #ifdef HAS_SENSORS
-// to come
-/*
-  uint8_t length = buf[0];
-  memcpy(buffer, buf+1, length);
-  cursor += length; // length of buffer
-*/
+  // sensor payload is preformatted by the sensor, length in first byte;
+  // Cayenne LPP has no data type for it yet
+  const uint8_t length = hasPorts() ? buf[0] : 0;
+  if (!fits(length))
+    return refuse(length);
+  writeBytes(buf + 1, length);
+  return true;
+#else
+  return false;
 #endif
 }
 
-void PayloadConvert::addBME(bmeStatus_t value) {
+bool PayloadConvert::addBME(bmeStatus_t value) {
 #ifdef HAS_BME
-
-  // data value conversions to meet cayenne data type definition
-  // 0.1°C per bit => -3276,7 .. +3276,7 °C
-  int16_t temperature = (int16_t)(value.temperature * 10.0);
-  // 0.1 hPa per bit => 0 .. 6553,6 hPa
-  uint16_t pressure = (uint16_t)(value.pressure * 10);
-  // 0.5% per bit => 0 .. 128 %C
-  uint8_t humidity = (uint8_t)(value.humidity * 2.0);
-  int16_t iaq = (int16_t)(value.iaq);
-
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_TEMPERATURE_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_TEMPERATURE; // 2 bytes 0.1 °C Signed MSB
-  buffer[cursor++] = highByte(temperature);
-  buffer[cursor++] = lowByte(temperature);
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_BAROMETER_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_BAROMETER; // 2 bytes 0.1 hPa Unsigned MSB
-  buffer[cursor++] = highByte(pressure);
-  buffer[cursor++] = lowByte(pressure);
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_HUMIDITY_CHANNEL;
-#endif
-  buffer[cursor++] = LPP_HUMIDITY; // 1 byte 0.5 % Unsigned
-  buffer[cursor++] = humidity;
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_AIR_CHANNEL;
+  PAYLOAD_RECORD(F::BME, bme(*this, value));
+#else
+  return false;
 #endif
-  buffer[cursor++] = LPP_LUMINOSITY; // 2 bytes, 1.0 unsigned
-  buffer[cursor++] = highByte(iaq);
-  buffer[cursor++] = lowByte(iaq);
-#endif // HAS_BME
 }
 
-void PayloadConvert::addButton(uint8_t value) {
+bool PayloadConvert::addButton(uint8_t value) {
 #ifdef HAS_BUTTON
-#if (PAYLOAD_ENCODER == 3)
-  buffer[cursor++] = LPP_BUTTON_CHANNEL;
+  PAYLOAD_RECORD(F::BUTTON, button(*this, value));
+#else
+  return false;
 #endif
-  buffer[cursor++] = LPP_DIGITAL_INPUT;
-  buffer[cursor++] = value;
-#endif // HAS_BUTTON
 }
 
-#else
-#error "No valid payload converter defined"
-#endif
\ No newline at end of file
+bool PayloadConvert::addSketch(uint8_t precision, uint8_t offset,
+                               const uint8_t regs[], uint8_t count) {
+  PAYLOAD_RECORD(F::SKETCH + F::SKETCH_REG * count,
+                 sketch(*this, precision, offset, regs, count));
+}
+
+bool PayloadConvert::addWindows(const uint8_t windows[],
+                                const uint16_t counts[], uint8_t n) {
+  PAYLOAD_RECORD(F::WINDOW * n, windows(*this, windows, counts, n));
+}
+
+bool PayloadConvert::addDwell(const uint16_t bins[], uint8_t n) {
+  PAYLOAD_RECORD(F::DWELL * n, dwell(*this, bins, n));
+}
+
+bool PayloadConvert::addChannels(const uint16_t yield[], const uint8_t share[],
+                                 uint8_t n) {
+  PAYLOAD_RECORD(F::CHANNEL * n, channels(*this, yield, share, n));
+}
+
+bool PayloadConvert::addBands(const uint16_t counts[], uint8_t n) {
+  PAYLOAD_RECORD(F::BAND * n, bands(*this, counts, n));
+}
+
+bool PayloadConvert::addVisits(uint16_t newpax, uint16_t returning,
+                               uint16_t departed) {
+  const uint16_t counts[] = {newpax, returning, departed};
+  PAYLOAD_RECORD(F::VISITS, visits(*this, counts));
+}
+
+bool PayloadConvert::addPerf(perfStatus_t value) {
+  const uint16_t counts[] = {value.wififrames,  value.bleadverts,
+                             value.rssidropped, value.vendordropped,
+                             value.ringdropped, value.collisions,
+                             value.insertns,    value.batchmaxus};
+  PAYLOAD_RECORD(F::PERF, perf(*this, counts));
+}
+
+bool PayloadConvert::addCountSeries(const uint8_t buf[], uint8_t n) {
+  // series is encoded by CountSeries already, Cayenne LPP has no data type
+  // for it
+  const uint8_t length = hasPorts() ? n : 0;
+  if (!fits(length))
+    return refuse(length);
+  writeBytes(buf, length);
+  return true;
+}
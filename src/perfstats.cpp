@@ -0,0 +1,80 @@
+// Basic Config
+#include "perfstats.h"
+#include "macqueue.h"
+
+// Local logging tag
+static const char TAG[] = "main";
+
+std::atomic<uint32_t> perf_counters[PERF_COUNTERS];
+static std::atomic<uint32_t> batch_max_us(0); // reset by housekeeping
+static perfStatus_t perf_status;
+
+// called by macloop task for each batch of records counted
+void IRAM_ATTR perf_batch(uint16_t records, uint32_t us) {
+  perf_count(PERF_RECORDS, records);
+  perf_count(PERF_COUNT_US, us);
+  if (us > batch_max_us.load(std::memory_order_relaxed))
+    batch_max_us.store(us, std::memory_order_relaxed);
+}
+
+// rate per second from counter increment over interval, rounded
+static uint16_t perf_rate(uint32_t delta, uint32_t ms) {
+  const uint64_t rate = ((uint64_t)delta * 1000 + ms / 2) / (ms ? ms : 1);
+  return rate < 65535 ? rate : 65535;
+}
+
+// derive rates since previous call, called by housekeeping
+void perf_update(void) {
+  static uint32_t last[PERF_COUNTERS], lastdropped, lastms;
+  uint32_t delta[PERF_COUNTERS];
+  const uint32_t now = millis(), ms = now - lastms;
+  uint32_t dropped = mac_queue_dropped(MAC_SNIFF_WIFI);
+#ifdef BLECOUNTER
+  dropped += mac_queue_dropped(MAC_SNIFF_BLE);
+#endif
+
+  for (uint8_t i = 0; i < PERF_COUNTERS; i++) {
+    const uint32_t value = perf_counters[i].load(std::memory_order_relaxed);
+    delta[i] = value - last[i];
+    last[i] = value;
+  }
+
+  perf_status.wififrames = perf_rate(delta[PERF_WIFI_FRAMES], ms);
+  perf_status.bleadverts = perf_rate(delta[PERF_BLE_ADVERTS], ms);
+  perf_status.rssidropped = perf_rate(
+      delta[PERF_WIFI_RSSI_DROPPED] + delta[PERF_BLE_RSSI_DROPPED], ms);
+  perf_status.vendordropped = perf_rate(
+      delta[PERF_VENDOR_DROPPED] + delta[PERF_BLE_VENDOR_DROPPED], ms);
+  perf_status.ringdropped = perf_rate(dropped - lastdropped, ms);
+  const uint32_t ns = delta[PERF_RECORDS] ? (uint64_t)delta[PERF_COUNT_US] *
+                                                1000 / delta[PERF_RECORDS]
+                                          : 0;
+  perf_status.insertns = ns < 65535 ? ns : 65535;
+  const uint32_t us = batch_max_us.exchange(0, std::memory_order_relaxed);
+  perf_status.batchmaxus = us < 65535 ? us : 65535;
+  lastdropped = dropped;
+  lastms = now;
+
+  ESP_LOGI(TAG,
+           "Sniffer: %d Wifi frames/s, %d BLE adverts/s, dropped %d/s by "
+           "RSSI limit, %d/s by vendor filter, %d/s by full rings; %d ns "
+           "per record, max. %d us per batch",
+           perf_status.wififrames, perf_status.bleadverts,
+           perf_status.rssidropped, perf_status.vendordropped,
+           perf_status.ringdropped, perf_status.insertns,
+           perf_status.batchmaxus);
+}
+
+// hash collisions expected for set bits n of a bitmap of m bits, by linear
+// counting estimate m * ln(m / (m - n)) - n
+static uint32_t collisions(const MacBitmap &bitmap) {
+  const double m = MACBITMAP_BITS, n = bitmap.size();
+  return n < m ? (uint32_t)(m * log(m / (m - n)) - n + 0.5) : 65535;
+}
+
+// rates of last housekeeping interval and collisions of this send cycle
+void perf_get(perfStatus_t *stats) {
+  const uint32_t c = collisions(macs) + collisions(blemacs);
+  *stats = perf_status;
+  stats->collisions = c < 65535 ? c : 65535;
+}
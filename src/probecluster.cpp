@@ -0,0 +1,97 @@
+#include "probecluster.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SEQ_MASK 0x0FFF // 12bit sequence number
+
+// entries must be a power of 2 and at least PROBE_WAYS, seqgap a power of 2
+ProbeClusters::ProbeClusters(uint16_t n, uint32_t w, uint16_t g)
+    : sets(n / PROBE_WAYS), window(w), seqgap(g) {
+  table = (ProbeCluster_t *)malloc(n * sizeof(ProbeCluster_t));
+  clear();
+}
+
+ProbeClusters::~ProbeClusters(void) { free(table); }
+
+void ProbeClusters::clear(void) {
+  if (table)
+    memset(table, 0, sets * PROBE_WAYS * sizeof(ProbeCluster_t));
+  probes = merged = 0;
+}
+
+uint32_t ProbeClusters::getProbes(void) const { return probes; }
+
+uint32_t ProbeClusters::getMerged(void) const { return merged; }
+
+// clusters are filed by fingerprint and block of seqgap sequence numbers, so
+// devices of the same model spread over the table
+ProbeCluster_t *ProbeClusters::set(uint32_t fingerprint, uint16_t block) {
+  const uint32_t h = (fingerprint ^ (block * 0x85EBCA6BUL)) * 0x9E3779B1UL;
+  return &table[((h >> 16) & (sets - 1)) * PROBE_WAYS];
+}
+
+// best continuation of sequence number seq in a set, or NULL
+ProbeCluster_t *ProbeClusters::find(ProbeCluster_t *s, uint32_t fingerprint,
+                                    uint16_t seq, uint32_t now,
+                                    uint16_t *bestgap) {
+  ProbeCluster_t *best = NULL;
+  uint16_t gap;
+  for (uint8_t i = 0; i < PROBE_WAYS; i++)
+    if ((s[i].fingerprint == fingerprint) && (now - s[i].lastseen <= window)) {
+      gap = (seq - s[i].seq) & SEQ_MASK;
+      if (gap <= *bestgap) {
+        *bestgap = gap;
+        best = &s[i];
+      }
+    }
+  return best;
+}
+
+// empty or least recently seen entry of a set
+ProbeCluster_t *ProbeClusters::victim(ProbeCluster_t *s) {
+  ProbeCluster_t *v = s;
+  for (uint8_t i = 0; i < PROBE_WAYS && v->fingerprint; i++)
+    if (!s[i].fingerprint || (int32_t)(s[i].lastseen - v->lastseen) < 0)
+      v = &s[i];
+  return v;
+}
+
+// returns MAC to count for a probe request with randomized MAC
+const uint8_t *ProbeClusters::match(uint32_t fingerprint, uint16_t seq,
+                                    const uint8_t *mac, uint32_t now) {
+  if (!table || !fingerprint)
+    return mac;
+
+  const uint16_t block = (seq & SEQ_MASK) / seqgap;
+  const uint16_t prev = (block ? block : (SEQ_MASK + 1) / seqgap) - 1;
+  ProbeCluster_t *home = set(fingerprint, block), *e;
+  uint16_t gap = seqgap;
+
+  probes++;
+
+  // a continuation is in the block of seq or the one before
+  e = find(set(fingerprint, prev), fingerprint, seq, now, &gap);
+  ProbeCluster_t *e2 = find(home, fingerprint, seq, now, &gap);
+  if (e2)
+    e = e2;
+
+  if (e) {
+    if (memcmp(e->mac, mac, 6))
+      merged++;
+    if ((e < home) || (e >= home + PROBE_WAYS)) {
+      // move cluster to block of its new sequence number
+      ProbeCluster_t *v = victim(home);
+      *v = *e;
+      e->fingerprint = 0;
+      e = v;
+    }
+  } else {
+    e = victim(home);
+    e->fingerprint = fingerprint;
+    memcpy(e->mac, mac, 6);
+  }
+  e->seq = seq;
+  e->lastseen = now;
+  return e->mac;
+}
@@ -8,6 +8,11 @@ static const char TAG[] = "main";
 // helper function
 void do_reset() {
   ESP_LOGI(TAG, "Remote command: restart device");
+#ifdef SNAPSHOT_SIZE
+  COUNT_MUTEX_LOCK();
+  snapshot_save(true); // continue counting after restart
+  COUNT_MUTEX_UNLOCK();
+#endif
   LMIC_shutdown();
   delay(3000);
   esp_restart();
@@ -22,8 +27,13 @@ void set_reset(uint8_t val[]) {
     break;
   case 1: // reset MAC counter
     ESP_LOGI(TAG, "Remote command: reset MAC counter");
+    COUNT_MUTEX_LOCK();
     reset_counters(); // clear macs
     get_salt();       // get new salt
+#ifdef SNAPSHOT_SIZE
+    snapshot_save(false);
+#endif
+    COUNT_MUTEX_UNLOCK();
     sprintf(display_line6, "Reset counter");
     break;
   case 2: // reset device to factory settings
@@ -100,14 +110,20 @@ void set_countmode(uint8_t val[]) {
     cfg.countermode = 2;
     ESP_LOGI(TAG, "Remote command: set counter mode to cyclic confirmed");
     break;
+  case 3: // cyclic with HyperLogLog sketch
+    cfg.countermode = 3;
+    ESP_LOGI(TAG, "Remote command: set counter mode to sketch");
+    break;
   default: // invalid parameter
     ESP_LOGW(
         TAG,
         "Remote command: set counter mode called with invalid parameter(s)");
     return;
   }
+  COUNT_MUTEX_LOCK();
   reset_counters(); // clear macs
   get_salt();       // get new salt
+  COUNT_MUTEX_UNLOCK();
 }
 
 void set_screensaver(uint8_t val[]) {
@@ -155,11 +171,12 @@ void set_sensor(uint8_t val[]) {
 }
 
 void set_beacon(uint8_t val[]) {
-  uint8_t id = val[0];           // use first parameter as beacon storage id
-  memmove(val, val + 1, 6);      // strip off storage id
-  beacons[id] = macConvert(val); // store beacon MAC in array
+  uint8_t id = val[0];      // use first parameter as beacon storage id
+  memmove(val, val + 1, 6); // strip off storage id
   ESP_LOGI(TAG, "Remote command: set beacon ID#%d", id);
   printKey("MAC", val, 6, false); // show beacon MAC
+  if (!beacon_set(id, macConvert(val))) // store beacon MAC in registry
+    ESP_LOGE(TAG, "Beacon ID#%d not stored, registry full", id);
 }
 
 void set_monitor(uint8_t val[]) {
@@ -168,6 +185,51 @@ void set_monitor(uint8_t val[]) {
   cfg.monitormode = val[0] ? 1 : 0;
 }
 
+void set_wififilter(uint8_t val[]) {
+  if (val[0] > WIFI_FILTER_PROBES) {
+    ESP_LOGW(TAG, "Remote command: Wifi filter profile %d invalid", val[0]);
+    return;
+  }
+  ESP_LOGI(TAG, "Remote command: set Wifi filter profile to %d", val[0]);
+  wifi_filter_set(val[0]);
+}
+
+void set_bleclasses(uint8_t val[]) {
+  if (val[0] > BLE_CLASS_ALL) {
+    ESP_LOGW(TAG, "Remote command: BLE classes 0x%02X invalid", val[0]);
+    return;
+  }
+  ESP_LOGI(TAG, "Remote command: set BLE classes to 0x%02X", val[0]);
+  cfg.bleclasses = val[0];
+}
+
+void set_rssibands(uint8_t val[]) {
+  if (!val[0] || val[0] >= val[1] || val[1] > 128) {
+    ESP_LOGW(TAG, "Remote command: RSSI band edges -%d, -%d invalid", val[0],
+             val[1]);
+    return;
+  }
+  cfg.rssiband[0] = val[0] * -1;
+  cfg.rssiband[1] = val[1] * -1;
+  ESP_LOGI(TAG, "Remote command: set RSSI band edges to %d, %d",
+           cfg.rssiband[0], cfg.rssiband[1]);
+#ifdef COUNT_BANDS
+  COUNT_MUTEX_LOCK();
+  bands_init();
+  COUNT_MUTEX_UNLOCK();
+#endif
+}
+
+void set_payloadformat(uint8_t val[]) {
+  if (!payload.setFormat(val[0])) {
+    ESP_LOGW(TAG, "Remote command: payload format %d invalid", val[0]);
+    return;
+  }
+  cfg.payloadformat = val[0];
+  ESP_LOGI(TAG, "Remote command: set payload format to %s",
+           payload.getFormatName());
+}
+
 void set_lorasf(uint8_t val[]) {
 #ifdef HAS_LORA
   ESP_LOGI(TAG, "Remote command: set LoRa SF to %d", val[0]);
@@ -273,6 +335,35 @@ void get_bme(uint8_t val[]) {
 #endif
 };
 
+void get_channels(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get Wifi channel statistics");
+  if (!payload.hasPorts()) {
+    ESP_LOGW(TAG, "Channel statistics not supported by Cayenne LPP payload "
+                  "encoder");
+    return;
+  }
+  uint16_t yield[CHANNEL_MAX];
+  uint8_t share[CHANNEL_MAX];
+  const uint8_t n = channel_stats(yield, share);
+  payload.reset();
+  payload.addChannels(yield, share, n);
+  SendPayload(CHANNELPORT);
+};
+
+void get_perf(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get sniffer performance counters");
+  if (!payload.hasPorts()) {
+    ESP_LOGW(TAG, "Performance counters not supported by Cayenne LPP payload "
+                  "encoder");
+    return;
+  }
+  perfStatus_t stats;
+  perf_get(&stats);
+  payload.reset();
+  payload.addPerf(stats);
+  SendPayload(PERFPORT);
+};
+
 // assign previously defined functions to set of numeric remote commands
 // format: opcode, function, #bytes params,
 // flag (true = do make settings persistent / false = don't)
@@ -287,9 +378,12 @@ cmd_t table[] = {
     {0x0d, set_vendorfilter, 1, false}, {0x0e, set_blescan, 1, true},
     {0x0f, set_wifiant, 1, true},       {0x10, set_rgblum, 1, true},
     {0x11, set_monitor, 1, true},       {0x12, set_beacon, 7, false},
-    {0x13, set_sensor, 2, true},        {0x80, get_config, 0, false},
+    {0x13, set_sensor, 2, true},        {0x14, set_wififilter, 1, true},
+    {0x15, set_bleclasses, 1, true},    {0x16, set_rssibands, 2, true},
+    {0x17, set_payloadformat, 1, true}, {0x80, get_config, 0, false},
     {0x81, get_status, 0, false},       {0x84, get_gps, 0, false},
-    {0x85, get_bme, 0, false},
+    {0x85, get_bme, 0, false},          {0x86, get_channels, 0, false},
+    {0x87, get_perf, 0, false},
 };
 
 const uint8_t cmdtablesize =
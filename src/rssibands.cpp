@@ -0,0 +1,36 @@
+#include "rssibands.h"
+
+#include <string.h>
+
+RssiBands::RssiBands(int8_t n, int8_t m) : near(n), mid(m) { clear(); }
+
+// rssi >= near edge is near, >= mid edge is mid, below is far
+void RssiBands::add(uint16_t hash, int8_t rssi) {
+  const uint8_t code =
+      RSSI_BANDS - (rssi >= near ? RSSI_BAND_NEAR
+                                 : (rssi >= mid ? RSSI_BAND_MID : RSSI_BAND_FAR));
+  uint32_t *word = &codes[hash >> 4];
+  const uint8_t shift = (hash & 0x0F) << 1;
+  const uint8_t old = (*word >> shift) & 0x03;
+
+  if (code <= old)
+    return; // device was already seen this near
+  *word += (uint32_t)(code - old) << shift;
+  counts[old]--; // counts[0] wraps, it is not read
+  counts[code]++;
+}
+
+uint16_t RssiBands::getCount(uint8_t band) const {
+  return band < RSSI_BANDS ? counts[RSSI_BANDS - band] : 0;
+}
+
+// edges apply to devices seen from now on
+void RssiBands::setEdges(int8_t n, int8_t m) {
+  near = n;
+  mid = m;
+}
+
+void RssiBands::clear(void) {
+  memset(codes, 0, sizeof(codes));
+  memset(counts, 0, sizeof(counts));
+}
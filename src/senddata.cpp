@@ -1,31 +1,167 @@
 // Basic Config
 #include "senddata.h"
 
+#ifdef SEND_AGGREGATE
+// Records of a send cycle are collected in one frame on AGGREGATEPORT, each
+// tagged with its port and length, and sent when the next one would exceed
+// the maximum payload of the current datarate. Cayenne LPP records need no
+// tags, they are concatenated on the LPP port. Only records of the task
+// which began collecting are collected, others, like replies to remote
+// commands from LMIC task, are sent on their own meanwhile.
+static MessageBuffer_t *aggregate;
+static uint8_t aggregate_records = 0, aggregate_port;
+static TaskHandle_t aggregator = NULL; // task collecting records, if any
+#endif
+
+// buffers of messages in send queues, referenced by each queue holding them
+BufferPool<MessageBuffer_t, SEND_POOL_SIZE> sendpool;
+
+#ifdef COUNT_SERIES
+CountSeries countseries(COUNT_SERIES);
+#endif
+
+// send class of messages on port, and key by which a newer message
+// supersedes a queued one: replies, readings and counts which are state
+// rather than events of a send cycle
+static uint8_t sendClass(uint8_t port, uint32_t *key) {
+  *key = 1UL << port;
+  switch (port) {
+  case BEACONPORT:
+  case BUTTONPORT:
+    *key = 0;
+    return SEND_ALARM;
+  case STATUSPORT:
+  case CONFIGPORT:
+  case CHANNELPORT:
+  case PERFPORT:
+    return SEND_RESPONSE;
+  case COUNTERPORT:
+    if (cfg.countermode != 1) // not cumulative, each cycle counts
+      *key = 0;
+    return SEND_COUNT;
+  case WINDOWPORT:
+    return SEND_COUNT;
+  case SKETCHPORT:
+  case DWELLPORT:
+  case BANDPORT:
+  case VISITPORT:
+  case SERIESPORT:
+    *key = 0;
+    return SEND_COUNT;
+  case GPSPORT:
+  case BMEPORT:
+  case BATTPORT:
+    return SEND_TELEMETRY;
+  default:
+    *key = 0;
+    return SEND_TELEMETRY;
+  }
+}
+
+static void enqueuePayload(MessageBuffer_t *message) {
+  // enqueue message in device's send queues, which take their own reference
+  lora_enqueuedata(message);
+  spi_enqueuedata(message);
+  sendpool.release(message);
+}
+
+#ifdef SEND_AGGREGATE
+static void flushAggregate(void) {
+  if (!aggregate_records)
+    return;
+  if (aggregate_records == 1 && aggregate->MessagePort == AGGREGATEPORT) {
+    // single record is sent as is, on its own port
+    aggregate->MessageSize -= 2;
+    memmove(aggregate->Message, aggregate->Message + 2, aggregate->MessageSize);
+    aggregate->MessagePort = aggregate_port;
+  }
+  enqueuePayload(aggregate);
+  aggregate_records = 0;
+}
+
+// append record to aggregate, returns false if it does not fit into a frame,
+// then records collected so far are sent first to keep their order. The
+// frame is as urgent as its most urgent record, and supersedes an older
+// one only if all its records do
+static bool addAggregate(uint8_t port, uint8_t prio, uint32_t key) {
+  const uint8_t tag = payload.hasPorts() ? 2 : 0; // port and length
+  const uint8_t max = lora_maxpayload();
+  const uint8_t size = payload.getSize();
+
+  if (aggregate_records && aggregate->MessageSize + size + tag > max)
+    flushAggregate();
+  if (size + tag > max)
+    return false;
+  if (!aggregate_records) {
+    if (!(aggregate = sendpool.alloc()))
+      return false;
+    aggregate->MessageSize = 0;
+    aggregate->MessagePrio = prio;
+    aggregate->MessageKey = key;
+  }
+  if (prio < aggregate->MessagePrio)
+    aggregate->MessagePrio = prio;
+  aggregate->MessageKey = aggregate->MessageKey && key
+                              ? aggregate->MessageKey | key
+                              : 0;
+
+  aggregate->MessagePort = tag ? AGGREGATEPORT : port;
+  if (tag) {
+    aggregate->Message[aggregate->MessageSize++] = port;
+    aggregate->Message[aggregate->MessageSize++] = size;
+  }
+  memcpy(aggregate->Message + aggregate->MessageSize, payload.getBuffer(),
+         size);
+  aggregate->MessageSize += size;
+  aggregate_port = port;
+  aggregate_records++;
+  return true;
+}
+
+// collect records of following SendPayload() calls in as few frames as
+// possible, until sendAggregate()
+void beginAggregate(void) {
+  aggregate_records = 0;
+  aggregator = xTaskGetCurrentTaskHandle();
+}
+
+void sendAggregate(void) {
+  flushAggregate();
+  aggregator = NULL;
+}
+#endif
+
 // put data to send in RTos Queues used for transmit over channels Lora and SPI
 void SendPayload(uint8_t port) {
 
-  MessageBuffer_t SendBuffer; // contains MessageSize, MessagePort, Message[]
+  MessageBuffer_t *SendBuffer; // contains MessageSize, MessagePort, Message[]
+  uint32_t key;
+  const uint8_t prio = sendClass(port, &key);
 
-  SendBuffer.MessageSize = payload.getSize();
-  switch (PAYLOAD_ENCODER) {
-  case 1:
-  case 2:
-    SendBuffer.MessagePort = port;
-    break;
-  case 3:
-    SendBuffer.MessagePort = LPP1PORT;
+  switch (payload.getFormat()) {
+  case PAYLOAD_LPP_DYNAMIC:
+    port = LPP1PORT;
     break;
-  case 4:
-    SendBuffer.MessagePort = LPP2PORT;
+  case PAYLOAD_LPP_PACKED:
+    port = LPP2PORT;
     break;
-  default:
-    SendBuffer.MessagePort = port;
   }
-  memcpy(SendBuffer.Message, payload.getBuffer(), payload.getSize());
-
-  // enqueue message in device's send queues
-  lora_enqueuedata(&SendBuffer);
-  spi_enqueuedata(&SendBuffer);
+#ifdef SEND_AGGREGATE
+  if (aggregator == xTaskGetCurrentTaskHandle() &&
+      addAggregate(port, prio, key))
+    return;
+#endif
+  if (!(SendBuffer = sendpool.alloc())) {
+    ESP_LOGW(TAG, "Send buffers exhausted, %d byte(s) dropped",
+             payload.getSize());
+    return;
+  }
+  SendBuffer->MessageSize = payload.getSize();
+  SendBuffer->MessagePort = port;
+  SendBuffer->MessagePrio = prio;
+  SendBuffer->MessageKey = key;
+  memcpy(SendBuffer->Message, payload.getBuffer(), payload.getSize());
+  enqueuePayload(SendBuffer);
 
 } // SendPayload
 
@@ -34,34 +170,92 @@ void sendCounter() {
 
   uint8_t bitmask = cfg.payloadmask;
   uint8_t mask = 1;
+  uint8_t flags;
+  uint16_t wifi, ble = 0, both = 0;
+  bool estimated, located = false;
 
+#ifdef SEND_AGGREGATE
+  beginAggregate();
+#endif
   while (bitmask) {
     switch (bitmask & mask) {
 
     case COUNT_DATA:
+      // no device must be counted while counts are taken, sent and reset
+      COUNT_MUTEX_LOCK();
+      // counts are exact while few hashes collide, else estimated
       payload.reset();
-      payload.addCount(macs_wifi, MAC_SNIFF_WIFI);
-      if (cfg.blescan)
-        payload.addCount(macs_ble, MAC_SNIFF_BLE);
+      wifi = macs.estimate(&estimated);
+      payload.addCount(wifi, MAC_SNIFF_WIFI);
+      flags = estimated ? COUNT_ESTIMATED_WIFI : 0;
+      if (cfg.blescan) {
+        ble = blemacs.estimate(&estimated);
+        payload.addCount(ble, MAC_SNIFF_BLE);
+        flags |= estimated ? COUNT_ESTIMATED_BLE : 0;
+#ifdef CROSS_DEDUP
+        both = mac_both();
+        payload.addCount(both, MAC_SNIFF_BOTH);
+        ESP_LOGI(TAG,
+                 "Wifi only %d, BLE only %d, both %d (%d by address), "
+                 "total %d",
+                 macs_wifi - mac_both(), macs_ble - mac_both(), mac_both(),
+                 crossdedup.getLinked(), macs_total);
+#endif
+      }
 
 #ifdef HAS_GPS
       if (gps.location.isValid()) { // send GPS position only if we have a fix
         gps_read();
         payload.addGPS(gps_status);
+        located = true;
       } else {
         ESP_LOGD(
             TAG,
             "No valid GPS position. GPS data not appended to counter data.");
       }
 #endif
+      // flags are appended only if set, so payload length tells
+      if (flags) {
+        payload.addCountFlags(flags);
+        ESP_LOGI(TAG, "Counts estimated, flags 0x%02X", flags);
+      }
 
-      SendPayload(COUNTERPORT);
+#ifdef COUNT_SERIES
+      const CountSample_t sample = {wifi, ble, both, flags};
+      if (!sendSeries(&sample, located))
+#endif
+        SendPayload(COUNTERPORT);
+      // send sketch registers if in sketch counter mode
+      if (cfg.countermode == 3)
+        sendSketch();
+#ifdef COUNT_WINDOWS
+      sendWindows();
+#endif
+#ifdef DWELL_ENTRIES
+      sendDwell();
+#endif
+#ifdef COUNT_BANDS
+      sendBands();
+#endif
+#ifdef COUNT_VISITS
+      sendVisits();
+#endif
+#if defined(COUNT_WINDOWS) || defined(DWELL_ENTRIES)
+      longsalt_check();
+#endif
       // clear counter if not in cumulative counter mode
       if (cfg.countermode != 1) {
+#ifdef COUNT_VISITS
+        visits_rotate(); // keep hashes of this cycle for one more cycle
+#endif
         reset_counters(); // clear macs container and reset all counters
         get_salt();       // get new salt for salting hashes
+#ifdef SNAPSHOT_SIZE
+        snapshot_save(false); // replace snapshot of cycle just sent
+#endif
         ESP_LOGI(TAG, "Counter cleared");
       }
+      COUNT_MUTEX_UNLOCK();
       break;
 
 #ifdef HAS_BME
@@ -115,9 +309,163 @@ void sendCounter() {
     bitmask &= ~mask;
     mask <<= 1;
   } // while (bitmask)
+#ifdef SEND_AGGREGATE
+  sendAggregate();
+#endif
 
 } // sendCounter()
 
+// send HyperLogLog registers, split in chunks fitting in maximum payload of
+// current datarate
+void sendSketch() {
+  if (!payload.hasPorts()) {
+    ESP_LOGW(TAG, "Sketch not supported by Cayenne LPP payload encoder");
+    return;
+  }
+
+  const uint16_t chunk = lora_maxpayload() - 2; // 2 bytes header
+  const uint8_t *regs = sketch.getRegisters();
+  uint16_t offset = 0, n;
+
+  ESP_LOGI(TAG, "Sketch estimate: %d", sketch.estimate());
+
+  while (offset < sketch.getSize()) {
+    n = sketch.getSize() - offset;
+    if (n > chunk)
+      n = chunk;
+    payload.reset();
+    payload.addSketch(sketch.getPrecision(), offset, regs + offset, n);
+    SendPayload(SKETCHPORT);
+    offset += n;
+  }
+} // sendSketch()
+
+#ifdef COUNT_WINDOWS
+// send unique counts of all sliding windows in one message
+void sendWindows() {
+  static const uint8_t windows[] = {COUNT_WINDOWS};
+  const uint8_t n = sizeof(windows);
+  uint16_t counts[n];
+
+  static_assert(sizeof(windows) <= 8, "Too many COUNT_WINDOWS");
+
+  if (!countwindow.isActive())
+    return;
+
+  countwindow.count(window_minute(), windows, counts, n);
+  payload.reset();
+  payload.addWindows(windows, counts, n);
+  SendPayload(WINDOWPORT);
+} // sendWindows()
+#endif
+
+#ifdef DWELL_ENTRIES
+// send histogram of dwell times of devices which left during send cycle
+void sendDwell() {
+  if (!dwelltable.isActive())
+    return;
+
+  dwelltable.expire(uptime_seconds(), DWELL_TIMEOUT);
+  ESP_LOGD(TAG, "Dwell table: %d devices present", dwelltable.getUsed());
+  payload.reset();
+  payload.addDwell(dwelltable.getHistogram(), DWELL_BINS);
+  SendPayload(DWELLPORT);
+  dwelltable.resetHistogram();
+} // sendDwell()
+#endif
+
+#ifdef COUNT_BANDS
+// send unique counts per RSSI band of this send cycle
+void sendBands() {
+  uint16_t counts[RSSI_BANDS];
+
+  for (uint8_t i = 0; i < RSSI_BANDS; i++)
+    counts[i] = rssibands.getCount(i);
+  ESP_LOGD(TAG, "RSSI bands: %d near, %d mid, %d far", counts[RSSI_BAND_NEAR],
+           counts[RSSI_BAND_MID], counts[RSSI_BAND_FAR]);
+  payload.reset();
+  payload.addBands(counts, RSSI_BANDS);
+  SendPayload(BANDPORT);
+} // sendBands()
+#endif
+
+#ifdef COUNT_VISITS
+// send new, returning and departed devices of this send cycle
+void sendVisits() {
+  uint16_t newpax, back, departed;
+
+  visits_get(&newpax, &back, &departed);
+  ESP_LOGI(TAG, "Visits: %d new, %d returning, %d departed", newpax, back,
+           departed);
+  payload.reset();
+  payload.addVisits(newpax, back, departed);
+  SendPayload(VISITPORT);
+} // sendVisits()
+#endif
+
+#ifdef COUNT_SERIES
+// keep counts of send cycles while LoRa is busy, then send all of them as
+// delta compressed runs instead of one message per cycle; returns false if
+// counts of this cycle, in payload, are to be sent as usual. Series carry no
+// GPS position, counts with one are sent as usual, kept ones after them.
+bool sendSeries(const CountSample_t *sample, bool located) {
+  uint8_t buf[PAYLOAD_BUFFER_SIZE], n, taken;
+  uint8_t content = cfg.blescan ? COUNTSERIES_BLE : 0;
+
+  if (!payload.hasPorts()) { // Cayenne LPP has no data type for it
+    countseries.clear();
+    return false;
+  }
+#ifdef CROSS_DEDUP
+  if (cfg.blescan)
+    content |= COUNTSERIES_BOTH;
+#endif
+
+  if (located)
+    SendPayload(COUNTERPORT);
+  else
+    countseries.add(sample);
+  if (lora_busy()) {
+    ESP_LOGI(TAG, "LoRa busy, counts of %d cycles kept (%d lost)",
+             countseries.getCount(), countseries.getLost());
+    return true;
+  }
+  if (!located && countseries.getCount() == 1) { // nothing kept
+    countseries.drop(1);
+    return false;
+  }
+
+  while ((n = countseries.encode(buf, lora_maxpayload(), content, &taken))) {
+    ESP_LOGI(TAG, "Sending counts of %d cycles in %d bytes", taken, n);
+    payload.reset();
+    payload.addCountSeries(buf, n);
+    SendPayload(SERIESPORT);
+    countseries.drop(taken);
+  }
+  return true;
+} // sendSeries()
+#endif
+
+// send all pending beacon alarms, as few messages as maximum payload of
+// current datarate allows
+void sendBeaconAlarms() {
+  // 2 bytes per alarm, but one alarm per message with LPP, channels are fixed
+  uint8_t max = payload.hasPorts() ? lora_maxpayload() / 2 : 1;
+  if (max > PAYLOAD_BUFFER_SIZE / 2)
+    max = PAYLOAD_BUFFER_SIZE / 2;
+  else if (!max)
+    max = 1;
+  int8_t rssi[PAYLOAD_BUFFER_SIZE / 2];
+  uint8_t ids[PAYLOAD_BUFFER_SIZE / 2], n;
+
+  while ((n = beacon_alarms(rssi, ids, max))) {
+    payload.reset();
+    for (uint8_t i = 0; i < n; i++)
+      payload.addAlarm(rssi[i], ids[i]);
+    SendPayload(BEACONPORT);
+  }
+} // sendBeaconAlarms()
+
 void flushQueues() {
   lora_queuereset();
   spi_queuereset();
@@ -0,0 +1,111 @@
+#include "sendscheduler.h"
+
+SendScheduler::SendScheduler(uint8_t n, SendRelease_t release)
+    : size(n), count(0), order(0), release(release) {
+  slots = (SendSlot_t *)calloc(size, sizeof(SendSlot_t));
+  memset(stats, 0, sizeof(stats));
+}
+
+SendScheduler::~SendScheduler(void) {
+  clear();
+  free(slots);
+}
+
+void SendScheduler::clear(void) {
+  for (uint8_t i = 0; i < size; i++)
+    if (slots[i].message)
+      remove(i);
+}
+
+uint8_t SendScheduler::getCount(void) const { return count; }
+
+const SendStats_t *SendScheduler::getStats(uint8_t cls) const {
+  return cls < SEND_CLASSES ? &stats[cls] : NULL;
+}
+
+// queue message, returns false if it was dropped
+bool SendScheduler::push(MessageBuffer_t *message) {
+  int16_t slot = -1;
+
+  if (message->MessagePrio >= SEND_CLASSES)
+    message->MessagePrio = SEND_TELEMETRY;
+  const uint8_t cls = message->MessagePrio;
+  stats[cls].queued++;
+
+  if (!slots) {
+    stats[cls].dropped++;
+    release(message);
+    return false;
+  }
+
+  // replace queued messages superseded by this one, the first one in place,
+  // so newer content goes out at the turn of the older one
+  for (uint8_t i = 0; message->MessageKey && i < size; i++) {
+    const MessageBuffer_t *queued = slots[i].message;
+    if (queued && queued->MessagePrio == cls &&
+        queued->MessageKey && !(queued->MessageKey & ~message->MessageKey)) {
+      stats[cls].coalesced++;
+      if (slot < 0) {
+        release(slots[i].message);
+        slots[i].message = message;
+        slot = i;
+      } else
+        remove(i);
+    }
+  }
+  if (slot >= 0)
+    return true;
+
+  // if full, make room by evicting the oldest of least urgent class
+  if (count == size) {
+    for (uint8_t c = SEND_CLASSES - 1; c > cls && slot < 0; c--)
+      slot = oldest(c);
+    if (slot < 0) {
+      stats[cls].dropped++;
+      release(message);
+      return false;
+    }
+    stats[slots[slot].message->MessagePrio].dropped++;
+    remove(slot);
+  }
+
+  for (slot = 0; slots[slot].message; slot++)
+    ;
+  slots[slot].message = message;
+  slots[slot].order = order++;
+  count++;
+  return true;
+}
+
+// remove and return oldest message of most urgent class, NULL if empty
+MessageBuffer_t *SendScheduler::pop(void) {
+  for (uint8_t c = 0; count && c < SEND_CLASSES; c++) {
+    const int16_t i = oldest(c);
+    if (i >= 0) {
+      MessageBuffer_t *message = slots[i].message;
+      slots[i].message = NULL;
+      count--;
+      return message;
+    }
+  }
+  return NULL;
+}
+
+// slot of oldest message of class, -1 if there is none
+int16_t SendScheduler::oldest(uint8_t cls) const {
+  int16_t found = -1;
+  for (uint8_t i = 0; i < size; i++) {
+    const MessageBuffer_t *message = slots[i].message;
+    // sequence numbers may wrap, so compare by distance
+    if (message && message->MessagePrio == cls &&
+        (found < 0 || (int32_t)(slots[i].order - slots[found].order) < 0))
+      found = i;
+  }
+  return found;
+}
+
+void SendScheduler::remove(uint8_t i) {
+  release(slots[i].message);
+  slots[i].message = NULL;
+  count--;
+}
@@ -0,0 +1,81 @@
+#include "snapshot.h"
+
+#include <rom/crc.h>
+#include <string.h>
+
+// header layout: magic(4) version(2) length(2) epoch(4) crc(4), length and
+// crc cover the state following the header
+static void put32(uint8_t *p, uint32_t v) { memcpy(p, &v, sizeof(v)); }
+static void put16(uint8_t *p, uint16_t v) { memcpy(p, &v, sizeof(v)); }
+static uint32_t get32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+static uint16_t get16(const uint8_t *p) {
+  uint16_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// returns bytes written, 0 if buf is too small
+size_t snapshot_encode(uint8_t *buf, size_t len, const Snapshot_t *state,
+                       const MacBitmap *wifi, const MacBitmap *ble) {
+  size_t n = SNAPSHOT_HEADER + SNAPSHOT_STATE, k;
+
+  if (len < n)
+    return 0;
+  put32(buf + 16, state->salt);
+  put16(buf + 20, state->total);
+  put16(buf + 22, state->wifi);
+  put16(buf + 24, state->ble);
+  if (!(k = wifi->save(buf + n, len - n)))
+    return 0;
+  n += k;
+  if (!(k = ble->save(buf + n, len - n)))
+    return 0;
+  n += k;
+
+  put32(buf, SNAPSHOT_MAGIC);
+  put16(buf + 4, SNAPSHOT_VERSION);
+  put16(buf + 6, n - SNAPSHOT_HEADER);
+  put32(buf + 8, state->epoch);
+  put32(buf + 12, crc32_le(0, buf + SNAPSHOT_HEADER, n - SNAPSHOT_HEADER));
+  return n;
+}
+
+// validate header and CRC without decoding, returns size of snapshot and
+// its epoch, 0 if invalid
+size_t snapshot_check(const uint8_t *buf, size_t len, uint32_t *epoch) {
+  if (len < SNAPSHOT_HEADER + SNAPSHOT_STATE ||
+      get32(buf) != SNAPSHOT_MAGIC || get16(buf + 4) != SNAPSHOT_VERSION)
+    return 0;
+  const size_t length = get16(buf + 6);
+  if (length < SNAPSHOT_STATE || length > len - SNAPSHOT_HEADER ||
+      get32(buf + 12) != crc32_le(0, buf + SNAPSHOT_HEADER, length))
+    return 0;
+  *epoch = get32(buf + 8);
+  return SNAPSHOT_HEADER + length;
+}
+
+// restore state and bitmaps, leaves all untouched if header or CRC are bad
+bool snapshot_decode(const uint8_t *buf, size_t len, Snapshot_t *state,
+                     MacBitmap *wifi, MacBitmap *ble) {
+  uint32_t epoch;
+  size_t n = SNAPSHOT_HEADER + SNAPSHOT_STATE, k;
+
+  if (!(len = snapshot_check(buf, len, &epoch)))
+    return false;
+  if (!(k = wifi->load(buf + n, len - n)) ||
+      !ble->load(buf + n + k, len - n - k)) {
+    wifi->clear(); // CRC matched, but content is broken
+    ble->clear();
+    return false;
+  }
+  state->epoch = epoch;
+  state->salt = get32(buf + 16);
+  state->total = get16(buf + 20);
+  state->wifi = get16(buf + 22);
+  state->ble = get16(buf + 24);
+  return true;
+}
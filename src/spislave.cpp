@@ -23,6 +23,7 @@ licenses. Refer to LICENSE.txt file in repository for more details.
 */
 
 #include "spislave.h"
+#include "sendscheduler.h"
 
 #include <driver/spi_slave.h>
 #include <sys/param.h>
@@ -41,37 +42,46 @@ static const char TAG[] = __FILE__;
 DMA_ATTR uint8_t txbuf[BUFFER_SIZE];
 DMA_ATTR uint8_t rxbuf[BUFFER_SIZE];
 
-QueueHandle_t SPISendQueue;
+// send queue, shared by producers and SPI task, guarded by spinlock
+static void spi_release(MessageBuffer_t *message) {
+  sendpool.release(message);
+}
+static SendScheduler SPISendQueue(SEND_QUEUE_SIZE, spi_release);
+static portMUX_TYPE queueMux = portMUX_INITIALIZER_UNLOCKED;
 
 TaskHandle_t spiTask;
 
 void spi_slave_task(void *param) {
   while (1) {
-    MessageBuffer_t msg;
+    MessageBuffer_t *msg;
     size_t transaction_size;
 
     // clear rx + tx buffers
     memset(txbuf, 0, sizeof(txbuf));
     memset(rxbuf, 0, sizeof(rxbuf));
 
-    // wait until data to send arrivey
-    if (xQueueReceive(SPISendQueue, &msg, portMAX_DELAY) != pdTRUE) {
-      ESP_LOGE(TAG, "Premature return from xQueueReceive() with no data!");
+    // wait until data to send arrives, producers notify after enqueueing
+    portENTER_CRITICAL(&queueMux);
+    msg = SPISendQueue.pop();
+    portEXIT_CRITICAL(&queueMux);
+    if (!msg) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
       continue;
     }
 
-    // fill tx buffer with data to send from queue
+    // fill tx buffer with data to send from queue, then buffer is not needed
     uint8_t *messageType = txbuf + 2;
-    *messageType = msg.MessagePort;
+    *messageType = msg->MessagePort;
     uint8_t *messageSize = txbuf + 3;
-    *messageSize = msg.MessageSize;
-    memcpy(txbuf + HEADER_SIZE, &msg.Message, msg.MessageSize);
+    *messageSize = msg->MessageSize;
+    memcpy(txbuf + HEADER_SIZE, msg->Message, msg->MessageSize);
+    sendpool.release(msg);
     // calculate crc16 checksum over txbuf and insert checksum at pos 0+1 of txbuf
     uint16_t *crc = (uint16_t *)txbuf;
-    *crc = crc16_be(0, messageType, msg.MessageSize + HEADER_SIZE - 2);
+    *crc = crc16_be(0, messageType, *messageSize + HEADER_SIZE - 2);
 
     // set length for spi slave driver
-    transaction_size = HEADER_SIZE + msg.MessageSize;
+    transaction_size = HEADER_SIZE + *messageSize;
     // SPI transaction size needs to be at least 8 bytes and dividable by 4, see
     // https://docs.espressif.com/projects/esp-idf/en/latest/api-reference/peripherals/spi_slave.html
     if (transaction_size % 4 != 0) {
@@ -104,13 +114,7 @@ esp_err_t spi_init() {
   return ESP_OK;
 #else
 
-  SPISendQueue = xQueueCreate(SEND_QUEUE_SIZE, sizeof(MessageBuffer_t));
-  if (SPISendQueue == 0) {
-    ESP_LOGE(TAG, "Could not create SPI send queue. Aborting.");
-    return ESP_FAIL;
-  }
-  ESP_LOGI(TAG, "SPI send queue created, size %d Bytes",
-           SEND_QUEUE_SIZE * PAYLOAD_BUFFER_SIZE);
+  ESP_LOGI(TAG, "SPI send queue created, size %d messages", SEND_QUEUE_SIZE);
 
   spi_bus_config_t spi_bus_cfg = {.mosi_io_num = SPI_MOSI,
                                   .miso_io_num = SPI_MISO,
@@ -149,22 +153,29 @@ esp_err_t spi_init() {
 }
 
 void spi_enqueuedata(MessageBuffer_t *message) {
-  // enqueue message in SPI send queue
+  // enqueue reference to message in SPI send queue
 #ifdef HAS_SPI
-  BaseType_t ret =
-      xQueueSendToBack(SPISendQueue, (void *)message, (TickType_t)0);
-  if (ret == pdTRUE) {
+  sendpool.retain(message);
+  portENTER_CRITICAL(&queueMux);
+  const bool ret = SPISendQueue.push(message);
+  portEXIT_CRITICAL(&queueMux);
+  if (ret) {
     ESP_LOGI(TAG, "%d byte(s) enqueued for SPI interface",
              message->MessageSize);
+    if (spiTask)
+      xTaskNotifyGive(spiTask);
   } else {
-    ESP_LOGW(TAG, "SPI sendqueue is full");
+    ESP_LOGW(TAG, "SPI sendqueue is full, class %d message dropped",
+             message->MessagePrio);
   }
 #endif
 }
 
 void spi_queuereset(void) {
 #ifdef HAS_SPI
-  xQueueReset(SPISendQueue);
+  portENTER_CRITICAL(&queueMux);
+  SPISendQueue.clear();
+  portEXIT_CRITICAL(&queueMux);
 #endif
 }
 
@@ -1,12 +1,21 @@
 // Basic Config
 #include "globals.h"
 #include "wifiscan.h"
+#include "macqueue.h"
 #include <esp_coexist.h>
 #include "coexist_internal.h"
 
 // Local logging tag
 static const char TAG[] = "wifi";
 
+static_assert((WIFI_CHANNEL_REVISIT == 0) ||
+                  (WIFI_CHANNEL_REVISIT > WIFI_CHANNEL_MAX - WIFI_CHANNEL_MIN),
+              "WIFI_CHANNEL_REVISIT too short to visit all channels");
+
+ChannelScheduler channelsched(WIFI_CHANNEL_MIN, WIFI_CHANNEL_MAX,
+                              WIFI_CHANNEL_REVISIT);
+static portMUX_TYPE channelMux = portMUX_INITIALIZER_UNLOCKED;
+
 static wifi_country_t wifi_country = {WIFI_MY_COUNTRY, WIFI_CHANNEL_MIN,
                                       WIFI_CHANNEL_MAX, 100,
                                       WIFI_COUNTRY_POLICY_MANUAL};
@@ -26,6 +35,111 @@ typedef struct {
   uint8_t payload[0]; // network data ended with 4 bytes csum (CRC32)
 } wifi_ieee80211_packet_t;
 
+// frame classes counted by each filter profile
+static const uint8_t filter_classes[] = {
+    0xFF, // WIFI_FILTER_ALL
+    (1 << WIFI_FRAME_PROBE) | (1 << WIFI_FRAME_ASSOC) |
+        (1 << WIFI_FRAME_TODS), // WIFI_FILTER_CLIENTS
+    (1 << WIFI_FRAME_PROBE)};   // WIFI_FILTER_PROBES
+
+// frames of each class seen by callback since device start
+static uint32_t frame_stats[WIFI_FRAME_CLASSES] = {0};
+
+// classify frame by frame control field, bits 2-3 type, 4-7 subtype,
+// 8 to DS, 9 from DS
+static inline IRAM_ATTR uint8_t wifi_classify(uint16_t fc,
+                                              const uint8_t *addr2) {
+  uint8_t frameclass;
+
+  switch ((fc >> 2) & 0x03) {
+  case 0: // management
+    switch ((fc >> 4) & 0x0F) {
+    case 4:
+      frameclass = WIFI_FRAME_PROBE;
+      break;
+    case 0: // association request
+    case 2: // reassociation request
+      frameclass = WIFI_FRAME_ASSOC;
+      break;
+    case 1: // association response
+    case 3: // reassociation response
+    case 5: // probe response
+    case 8: // beacon
+      frameclass = WIFI_FRAME_AP;
+      break;
+    default:
+      frameclass = WIFI_FRAME_MGMT;
+    }
+    break;
+  case 2: // data
+    switch ((fc >> 8) & 0x03) {
+    case 1:
+      frameclass = WIFI_FRAME_TODS;
+      break;
+    case 2:
+      frameclass = WIFI_FRAME_AP;
+      break;
+    default:
+      frameclass = WIFI_FRAME_DATA;
+    }
+    break;
+  default: // control frames have no or no reliable sender address
+    return WIFI_FRAME_CTRL;
+  }
+
+  // group bit set is no valid sender
+  return (addr2[0] & 0x01) ? WIFI_FRAME_GROUP : frameclass;
+}
+
+#ifdef PROBE_FINGERPRINT
+#define FNV_PRIME 16777619UL
+#define FNV_OFFSET 2166136261UL
+#define PROBE_IE_MAX 32 // max. information elements parsed per frame
+
+static inline IRAM_ATTR uint32_t fnv1a(uint32_t h, const uint8_t *p,
+                                       uint8_t len) {
+  while (len--)
+    h = (h ^ *p++) * FNV_PRIME;
+  return h;
+}
+
+// hash of those information elements of a probe request, which depend on
+// the device model and not on MAC, SSID, channel or time; parses the frame
+// in place and stops after PROBE_IE_MAX elements, so cost is bounded
+IRAM_ATTR uint32_t probe_fingerprint(const uint8_t *ie, uint16_t len) {
+  const uint8_t *end = ie + len;
+  uint32_t h = FNV_OFFSET;
+
+  for (uint8_t n = 0; (n < PROBE_IE_MAX) && (ie + 2 <= end); n++) {
+    const uint8_t id = ie[0], size = ie[1];
+    if (ie + 2 + size > end)
+      break; // truncated element
+    switch (id) {
+    case 0: // SSID
+    case 3: // DS parameter set, channel
+      break;
+    case 1:   // supported rates
+    case 45:  // HT capabilities
+    case 50:  // extended supported rates
+    case 127: // extended capabilities
+    case 191: // VHT capabilities
+      h = fnv1a(h, ie, size + 2);
+      break;
+    case 221: // vendor specific, OUI and type only, WPS content varies
+      h = fnv1a(fnv1a(h, ie, 1), ie + 2, size < 4 ? size : 4);
+      break;
+    case 255: // element id extension, e.g. HE capabilities
+      h = fnv1a(fnv1a(h, ie, 1), ie + 2, size < 1 ? size : 1);
+      break;
+    default: // order of other elements
+      h = fnv1a(h, ie, 1);
+    }
+    ie += 2 + size;
+  }
+  return h ? h : 1; // 0 means no fingerprint
+}
+#endif
+
 // using IRAM_:ATTR here to speed up callback function
 IRAM_ATTR void wifi_sniffer_packet_handler(void *buff,
                                            wifi_promiscuous_pkt_type_t type) {
@@ -34,13 +148,62 @@ IRAM_ATTR void wifi_sniffer_packet_handler(void *buff,
   const wifi_ieee80211_packet_t *ipkt =
       (wifi_ieee80211_packet_t *)ppkt->payload;
   const wifi_ieee80211_mac_hdr_t *hdr = &ipkt->hdr;
+  const uint8_t frameclass = wifi_classify(hdr->frame_ctrl, hdr->addr2);
+
+  perf_count(PERF_WIFI_FRAMES);
+
+  // drop frames not sent by clients before they reach the counter
+  frame_stats[frameclass]++;
+  if (!(filter_classes[cfg.wififilter] & (1 << frameclass)))
+    return;
 
   if ((cfg.rssilimit) &&
-      (ppkt->rx_ctrl.rssi < cfg.rssilimit)) // rssi is negative value
+      (ppkt->rx_ctrl.rssi < cfg.rssilimit)) { // rssi is negative value
+    perf_count(PERF_WIFI_RSSI_DROPPED);
     ESP_LOGD(TAG, "WiFi RSSI %d -> ignoring (limit: %d)", ppkt->rx_ctrl.rssi,
              cfg.rssilimit);
-  else // count seen MAC
-    mac_add((uint8_t *)hdr->addr2, ppkt->rx_ctrl.rssi, MAC_SNIFF_WIFI);
+  } else {
+    uint32_t fingerprint = 0;
+#ifdef PROBE_FINGERPRINT
+    // probe requests with locally administered, thus randomized, MAC;
+    // elements follow 24 byte header, frame ends with 4 byte checksum
+    if ((frameclass == WIFI_FRAME_PROBE) && (hdr->addr2[0] & 0x02) &&
+        (ppkt->rx_ctrl.sig_len > 28))
+      fingerprint =
+          probe_fingerprint(ppkt->payload + 24, ppkt->rx_ctrl.sig_len - 28);
+#endif
+    // queue seen MAC for counting
+    mac_enqueue(hdr->addr2, ppkt->rx_ctrl.rssi, ppkt->rx_ctrl.channel,
+                MAC_SNIFF_WIFI, fingerprint, hdr->sequence_ctrl >> 4);
+  }
+}
+
+// frames of a class seen since device start
+uint32_t wifi_frames(uint8_t frameclass) {
+  return frameclass < WIFI_FRAME_CLASSES ? frame_stats[frameclass] : 0;
+}
+
+// true if frames of a class pass the current filter profile
+bool wifi_filter_passes(uint8_t frameclass) {
+  return filter_classes[cfg.wififilter] & (1 << frameclass);
+}
+
+// driver passes only frame types which can pass the filter profile
+static uint32_t filter_mask(uint8_t profile) {
+  switch (profile) {
+  case WIFI_FILTER_CLIENTS:
+    return WIFI_PROMIS_FILTER_MASK_MGMT | WIFI_PROMIS_FILTER_MASK_DATA;
+  case WIFI_FILTER_PROBES:
+    return WIFI_PROMIS_FILTER_MASK_MGMT;
+  default:
+    return WIFI_PROMIS_FILTER_MASK_ALL;
+  }
+}
+
+void wifi_filter_set(uint8_t profile) {
+  wifi_promiscuous_filter_t filter = {.filter_mask = filter_mask(profile)};
+  cfg.wififilter = profile;
+  esp_wifi_set_promiscuous_filter(&filter);
 }
 
 void wifi_sniffer_init(void) {
@@ -48,8 +211,7 @@ void wifi_sniffer_init(void) {
   cfg.nvs_enable = 0;        // we don't need any wifi settings from NVRAM
   cfg.wifi_task_core_id = 0; // we want wifi task running on core 0
   wifi_promiscuous_filter_t filter = {
-      // .filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT}; // only MGMT frames
-      .filter_mask = WIFI_PROMIS_FILTER_MASK_ALL}; // we use all frames
+      .filter_mask = filter_mask(::cfg.wififilter)}; // frames of profile
 
   ESP_ERROR_CHECK(esp_coex_preference_set(
       ESP_COEX_PREFER_BALANCE)); // configure Wifi/BT coexist lib
@@ -67,14 +229,53 @@ void wifi_sniffer_init(void) {
   ESP_ERROR_CHECK(esp_wifi_set_promiscuous(true)); // now switch on monitor mode
 }
 
+// count a new unique device found on a Wifi channel, called by macloop task
+void channel_hit(uint8_t ch) {
+  portENTER_CRITICAL(&channelMux);
+  channelsched.hit(ch);
+  portEXIT_CRITICAL(&channelMux);
+}
+
+// per channel yield [new devices per minute] and share of listening time [%]
+// since last call, returns number of channels
+uint8_t channel_stats(uint16_t yield[], uint8_t share[]) {
+  const uint8_t n = WIFI_CHANNEL_MAX - WIFI_CHANNEL_MIN + 1;
+  uint32_t y, total = 0;
+
+  portENTER_CRITICAL(&channelMux);
+  for (uint8_t i = 0; i < n; i++)
+    total += channelsched.getSlots(WIFI_CHANNEL_MIN + i);
+  for (uint8_t i = 0; i < n; i++) {
+    // yield is per slot of wifichancycle/100 seconds, fixed point
+    y = channelsched.getYield(WIFI_CHANNEL_MIN + i) * 6000UL /
+        ((cfg.wifichancycle ? cfg.wifichancycle : 1) * CHANNEL_YIELD_ONE);
+    yield[i] = y > 0xFFFF ? 0xFFFF : y;
+    share[i] =
+        total ? channelsched.getSlots(WIFI_CHANNEL_MIN + i) * 100 / total : 0;
+  }
+  channelsched.resetStats();
+  portEXIT_CRITICAL(&channelMux);
+
+  return n;
+}
+
+// switch to channel chosen by scheduler for next channel switch interval
+void channel_switch(void) {
+  portENTER_CRITICAL(&channelMux);
+  const uint8_t ch = channelsched.next();
+  portEXIT_CRITICAL(&channelMux);
+  if (ch != channel) {
+    channel = ch;
+    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+  }
+  // ESP_LOGD(TAG, "Wifi set channel %d", channel);
+}
+
 // Wifi channel rotation task
 void switchWifiChannel(void *parameter) {
   while (1) {
     ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // waiting for channel switch timer
-    channel =
-        (channel % WIFI_CHANNEL_MAX) + 1; // rotate channel 1..WIFI_CHANNEL_MAX
-    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
-    //ESP_LOGD(TAG, "Wifi set channel %d", channel);
+    channel_switch();
   }
   vTaskDelete(NULL); // shoud never be reached
 }
@@ -0,0 +1,291 @@
+// Unit tests of the counting containers, native build
+// usage: pio test -e native -f test_containers
+
+#include "globals.h"
+#include "hash.h"
+#include "ringbuffer.h"
+#include "countwindow.h"
+#include "dwelltable.h"
+#include "beaconregistry.h"
+
+#include <unity.h>
+
+static MacBitmap bitmap, other;
+
+// distinct MAC of device i, as 32bit hash for sketches
+static uint32_t device_hash(uint32_t i, uint32_t key) {
+  uint8_t mac[6] = {0x02, 0x00};
+  memcpy(mac + 2, &i, 4);
+  return mac_hash32(mac, key);
+}
+
+void setUp(void) {
+  bitmap.clear();
+  other.clear();
+}
+
+void tearDown(void) {}
+
+void test_macbitmap_insert(void) {
+  TEST_ASSERT_TRUE(bitmap.insert(4711).second);
+  TEST_ASSERT_FALSE(bitmap.insert(4711).second);
+  TEST_ASSERT_TRUE(bitmap.insert(0).second);
+  TEST_ASSERT_TRUE(bitmap.insert(0xFFFF).second);
+  TEST_ASSERT_EQUAL_UINT(3, bitmap.size());
+  TEST_ASSERT_TRUE(bitmap.contains(4711));
+  TEST_ASSERT_FALSE(bitmap.contains(4712));
+  TEST_ASSERT_EQUAL_UINT(1, bitmap.erase(4711));
+  TEST_ASSERT_EQUAL_UINT(0, bitmap.erase(4711));
+  TEST_ASSERT_EQUAL_UINT(2, bitmap.size());
+  bitmap.clear();
+  TEST_ASSERT_EQUAL_UINT(0, bitmap.size());
+  TEST_ASSERT_FALSE(bitmap.contains(0xFFFF));
+}
+
+void test_macbitmap_merge(void) {
+  for (uint16_t i = 0; i < 100; i++) {
+    bitmap.insert(i);
+    other.insert(i + 50);
+  }
+  bitmap.merge(other);
+  TEST_ASSERT_EQUAL_UINT(150, bitmap.size());
+  TEST_ASSERT_TRUE(bitmap.contains(149));
+}
+
+// few hashes are counted exactly, many by linear counting within 2%
+void test_macbitmap_estimate(void) {
+  bool estimated;
+  for (uint16_t i = 0; i < 500; i++)
+    bitmap.insert(i * 131);
+  TEST_ASSERT_EQUAL_UINT(500, bitmap.estimate(&estimated));
+  TEST_ASSERT_FALSE(estimated);
+
+  bitmap.clear();
+  for (uint32_t i = 0; i < 30000; i++)
+    bitmap.insert(device_hash(i, 0x1234));
+  const uint16_t count = bitmap.estimate(&estimated);
+  TEST_ASSERT_TRUE(estimated);
+  TEST_ASSERT_UINT_WITHIN(600, 30000, count);
+}
+
+// sparse and raw serialization restore the same set
+void test_macbitmap_save_load(void) {
+  static uint8_t buf[MACBITMAP_SAVED_MAX];
+  static const uint32_t levels[] = {0, 1, 100, 5000, 40000};
+  for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+    bitmap.clear();
+    for (uint32_t i = 0; i < levels[l]; i++)
+      bitmap.insert(device_hash(i, l));
+    const size_t n = bitmap.save(buf, sizeof(buf));
+    TEST_ASSERT_TRUE(n > 0 && n <= MACBITMAP_SAVED_MAX);
+    TEST_ASSERT_EQUAL_UINT(n, other.load(buf, n));
+    TEST_ASSERT_EQUAL_UINT(bitmap.size(), other.size());
+    for (uint32_t h = 0; h < MACBITMAP_BITS; h++)
+      TEST_ASSERT_EQUAL(bitmap.contains(h), other.contains(h));
+  }
+  TEST_ASSERT_EQUAL_UINT(0, other.load(buf, 0));
+}
+
+void test_ringbuffer_fifo(void) {
+  RingBuffer<uint32_t, 8> ring;
+  uint32_t buf[8];
+  TEST_ASSERT_TRUE(ring.empty());
+  for (uint32_t i = 0; i < 8; i++)
+    TEST_ASSERT_EQUAL_UINT(i + 1, ring.push(i));
+  TEST_ASSERT_EQUAL_UINT(0, ring.push(8)); // full, dropped
+  TEST_ASSERT_EQUAL_UINT(1, ring.getDropped());
+  TEST_ASSERT_EQUAL_UINT(8, ring.getHighwater());
+  TEST_ASSERT_EQUAL_UINT(3, ring.pop(buf, 3));
+  TEST_ASSERT_EQUAL_UINT(0, buf[0]);
+  TEST_ASSERT_EQUAL_UINT(2, buf[2]);
+  TEST_ASSERT_EQUAL_UINT(5, ring.pop(buf, 8));
+  TEST_ASSERT_EQUAL_UINT(7, buf[4]);
+  TEST_ASSERT_TRUE(ring.empty());
+  TEST_ASSERT_EQUAL_UINT(0, ring.pop(buf, 8));
+}
+
+// indices wrap many times without losing order
+void test_ringbuffer_wrap(void) {
+  RingBuffer<uint16_t, 4> ring;
+  uint16_t buf[4], next = 0;
+  for (uint16_t i = 0; i < 1000; i++) {
+    ring.push(i);
+    if (i % 3 == 2) {
+      const uint16_t n = ring.pop(buf, 4);
+      for (uint16_t j = 0; j < n; j++)
+        TEST_ASSERT_EQUAL_UINT(next++, buf[j]);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT(0, ring.getDropped());
+  TEST_ASSERT_EQUAL_UINT(3, ring.getHighwater());
+}
+
+// estimate within three standard errors, 1.04/sqrt(registers)
+void test_hyperloglog_estimate(void) {
+  static const uint32_t levels[] = {100, 1000, 10000, 100000};
+  for (uint8_t p = HLL_PRECISION_MIN; p <= HLL_PRECISION_MAX; p++) {
+    HyperLogLog hll(p);
+    TEST_ASSERT_EQUAL_UINT(1 << p, hll.getSize());
+    TEST_ASSERT_EQUAL_UINT(0, hll.estimate());
+    for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+      hll.clear();
+      for (uint32_t i = 0; i < levels[l]; i++)
+        hll.add(device_hash(i, HLL_KEY));
+      const double error = 3 * 1.04 / sqrt(hll.getSize());
+      TEST_ASSERT_UINT_WITHIN(levels[l] * error, levels[l], hll.estimate());
+    }
+  }
+}
+
+// duplicates do not change registers; merging sketches of overlapping sets
+// by object or by register chunks as received counts their union
+void test_hyperloglog_merge(void) {
+  HyperLogLog a(8), b(8), c(8);
+  for (uint32_t i = 0; i < 3000; i++) {
+    a.add(device_hash(i, HLL_KEY));
+    b.add(device_hash(i + 2000, HLL_KEY));
+  }
+  for (uint32_t i = 0; i < 3000; i++)
+    TEST_ASSERT_FALSE(a.add(device_hash(i, HLL_KEY)));
+  c.merge(b);
+  TEST_ASSERT_TRUE(c.merge(a.getRegisters(), 0, 100));
+  TEST_ASSERT_TRUE(c.merge(a.getRegisters() + 100, 100, 156));
+  TEST_ASSERT_FALSE(c.merge(a.getRegisters(), 200, 100)); // beyond registers
+  a.merge(b);
+  TEST_ASSERT_EQUAL_MEMORY(a.getRegisters(), c.getRegisters(), a.getSize());
+  TEST_ASSERT_UINT_WITHIN(5000 * 3 * 0.065, 5000, a.estimate());
+}
+
+void test_countwindow(void) {
+  static uint8_t arena[COUNTWINDOW_SIZE];
+  static const uint8_t windows[] = {1, 5, 15};
+  uint16_t counts[3];
+  CountWindow window;
+
+  window.count(10, windows, counts, 3); // not begun, counts nothing
+  TEST_ASSERT_EQUAL_UINT(0, counts[2]);
+  TEST_ASSERT_FALSE(window.isActive());
+  window.begin(arena);
+  TEST_ASSERT_TRUE(window.isActive());
+
+  // hash h seen last at minute 100 - h, hash 0 twice
+  for (uint16_t h = 0; h < 20; h++)
+    window.add(h, 100 - h);
+  window.add(0, 100);
+  window.count(100, windows, counts, 3);
+  TEST_ASSERT_EQUAL_UINT(1, counts[0]);
+  TEST_ASSERT_EQUAL_UINT(5, counts[1]);
+  TEST_ASSERT_EQUAL_UINT(15, counts[2]);
+
+  // stamps older than largest window expire, minutes wrap around
+  window.count(130, windows, counts, 3);
+  TEST_ASSERT_EQUAL_UINT(0, counts[2]);
+  window.add(7, 300);
+  window.count(300, windows, counts, 3);
+  TEST_ASSERT_EQUAL_UINT(1, counts[0]);
+  window.clear();
+  window.count(300, windows, counts, 3);
+  TEST_ASSERT_EQUAL_UINT(0, counts[2]);
+}
+
+void test_dwelltable(void) {
+  static uint8_t arena[4 * (sizeof(DwellEntry_t) + sizeof(uint16_t))];
+  DwellTable dwell;
+  TEST_ASSERT_EQUAL_UINT(sizeof(arena), DwellTable::arenaSize(4));
+  dwell.begin(arena, 4);
+
+  dwell.seen(1, 0);
+  dwell.seen(5, 0); // same bucket as 1
+  dwell.seen(1, 30);
+  TEST_ASSERT_EQUAL_UINT(2, dwell.getUsed());
+
+  // device 5 left after 0 s -> bin 0, device 1 stays
+  dwell.expire(170, 150);
+  TEST_ASSERT_EQUAL_UINT(1, dwell.getUsed());
+  TEST_ASSERT_EQUAL_UINT(1, dwell.getHistogram()[0]);
+
+  // full table evicts least recently seen device 1, seen 0 .. 600 s -> bin 4
+  dwell.seen(1, 600);
+  for (uint16_t h = 10; h < 14; h++)
+    dwell.seen(h, 700);
+  TEST_ASSERT_EQUAL_UINT(4, dwell.getUsed());
+  TEST_ASSERT_EQUAL_UINT(1, dwell.getHistogram()[4]);
+
+  // visits of 64 minutes or more go to last bin
+  dwell.seen(10, 700 + 3 * 3600);
+  dwell.expire(700 + 4 * 3600, 300);
+  TEST_ASSERT_EQUAL_UINT(0, dwell.getUsed());
+  TEST_ASSERT_EQUAL_UINT(1, dwell.getHistogram()[DWELL_BINS - 1]);
+  TEST_ASSERT_EQUAL_UINT(4, dwell.getHistogram()[0]);
+  dwell.resetHistogram();
+  TEST_ASSERT_EQUAL_UINT(0, dwell.getHistogram()[0]);
+}
+
+void test_beaconregistry_alarm(void) {
+  BeaconRegistry registry(8, 60);
+  int8_t rssi[4];
+  uint8_t ids[4], id = 0;
+
+  TEST_ASSERT_TRUE(registry.set(3, 0x112233445566ULL));
+  TEST_ASSERT_EQUAL_UINT(BEACON_UNKNOWN,
+                         registry.seen(0x112233445567ULL, -70, 0, &id));
+  TEST_ASSERT_EQUAL_UINT(BEACON_ALARM,
+                         registry.seen(0x112233445566ULL, -70, 0, &id));
+  TEST_ASSERT_EQUAL_UINT(3, id);
+  // pending alarm is raised once, RSSI smoothed by 1/4
+  TEST_ASSERT_EQUAL_UINT(BEACON_KNOWN,
+                         registry.seen(0x112233445566ULL, -50, 1, &id));
+  TEST_ASSERT_EQUAL_UINT(1, registry.collectAlarms(rssi, ids, 4));
+  TEST_ASSERT_EQUAL_INT(-65, rssi[0]);
+  TEST_ASSERT_EQUAL_UINT(3, ids[0]);
+  TEST_ASSERT_EQUAL_UINT(0, registry.collectAlarms(rssi, ids, 4));
+  // no new alarm within holdoff
+  TEST_ASSERT_EQUAL_UINT(BEACON_KNOWN,
+                         registry.seen(0x112233445566ULL, -50, 59, &id));
+  TEST_ASSERT_EQUAL_UINT(BEACON_ALARM,
+                         registry.seen(0x112233445566ULL, -50, 60, &id));
+}
+
+// table takes 3/4 of its slots; an id stands for one MAC; removing an entry
+// keeps entries behind it in its probe sequence
+void test_beaconregistry_set(void) {
+  BeaconRegistry registry(8, 60);
+  uint8_t id;
+  for (uint8_t i = 0; i < 6; i++)
+    TEST_ASSERT_TRUE(registry.set(i, 0x100 + i));
+  TEST_ASSERT_FALSE(registry.set(6, 0x106));
+  TEST_ASSERT_FALSE(registry.set(BEACON_ID_MAX + 1, 0x107));
+  TEST_ASSERT_EQUAL_UINT(6, registry.getCount());
+
+  TEST_ASSERT_TRUE(registry.set(2, 0x202)); // id 2 moves to new MAC
+  TEST_ASSERT_EQUAL_UINT(6, registry.getCount());
+  TEST_ASSERT_EQUAL_UINT(BEACON_UNKNOWN, registry.seen(0x102, -70, 0, &id));
+  TEST_ASSERT_TRUE(registry.set(0, 0)); // removes id 0
+  TEST_ASSERT_EQUAL_UINT(5, registry.getCount());
+  TEST_ASSERT_EQUAL_UINT(BEACON_UNKNOWN, registry.seen(0x100, -70, 0, &id));
+  for (uint8_t i = 1; i < 6; i++) {
+    TEST_ASSERT_EQUAL_UINT(BEACON_ALARM,
+                           registry.seen(i == 2 ? 0x202 : 0x100 + i, -70, 0,
+                                         &id));
+    TEST_ASSERT_EQUAL_UINT(i, id);
+  }
+  registry.clear();
+  TEST_ASSERT_EQUAL_UINT(0, registry.getCount());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_macbitmap_insert);
+  RUN_TEST(test_macbitmap_merge);
+  RUN_TEST(test_macbitmap_estimate);
+  RUN_TEST(test_macbitmap_save_load);
+  RUN_TEST(test_ringbuffer_fifo);
+  RUN_TEST(test_ringbuffer_wrap);
+  RUN_TEST(test_hyperloglog_estimate);
+  RUN_TEST(test_hyperloglog_merge);
+  RUN_TEST(test_countwindow);
+  RUN_TEST(test_dwelltable);
+  RUN_TEST(test_beaconregistry_alarm);
+  RUN_TEST(test_beaconregistry_set);
+  return UNITY_END();
+}
@@ -0,0 +1,255 @@
+// Unit tests of device counting from sniffed MACs to send cycle, native build
+// usage: pio test -e native -f test_counting
+
+#include "globals.h"
+#include "configmanager.h"
+#include "senddata.h"
+#include "snapshot.h"
+#include "native/fixtures.h"
+#ifdef VENDORFILTER
+#include "vendor_array.h"
+#endif
+
+#include <unity.h>
+#include <malloc.h>
+#include <stdlib.h>
+
+// MAC of device i of a venue, with an OUI passing the vendor filter
+static void make_mac(uint8_t mac[6], uint32_t i, uint8_t venue) {
+  for (uint8_t b = 0; b < 6; b++)
+    mac[b] = (uint64_t)(i * 0x9E3779B1UL + venue) >> (8 * b);
+#ifdef VENDORFILTER
+  const uint32_t oui = vendors[i % VENDORS_COUNT];
+  mac[0] = oui >> 16;
+  mac[1] = oui >> 8;
+  mac[2] = oui;
+#endif
+}
+
+// count device as mac loop does
+static bool count(const uint8_t mac[6]) {
+  uint8_t copy[6];
+  memcpy(copy, mac, 6);
+  COUNT_MUTEX_LOCK();
+  const bool added = mac_add(copy, mac_hash(copy, salt), -70, MAC_SNIFF_WIFI);
+  COUNT_MUTEX_UNLOCK();
+  return added;
+}
+
+void setUp(void) {
+  sendCounter(); // start with empty counters
+}
+
+void tearDown(void) {}
+
+// a device is counted once per send cycle, counters restart after sending
+void test_mac_add(void) {
+  uint8_t mac[6];
+  for (uint8_t i = 0; i < 10; i++) {
+    make_mac(mac, i, 0);
+    TEST_ASSERT_TRUE(count(mac));
+    TEST_ASSERT_FALSE(count(mac));
+  }
+  TEST_ASSERT_EQUAL_UINT(10, macs_wifi);
+  TEST_ASSERT_EQUAL_UINT(10, macs.size());
+  sendCounter();
+  TEST_ASSERT_EQUAL_UINT(0, macs_wifi);
+  TEST_ASSERT_TRUE(count(mac));
+}
+
+#ifdef VENDORFILTER
+// binary search finds each table entry and nothing between them, as a
+// linear search of the table does
+void test_vendorfilter(void) {
+  for (uint16_t i = 0; i < VENDORS_COUNT; i++) {
+    TEST_ASSERT_TRUE(isVendor(vendors[i]));
+    const uint32_t next = vendors[i] + 1;
+    TEST_ASSERT_EQUAL(std::find(vendors, vendors + VENDORS_COUNT, next) !=
+                          vendors + VENDORS_COUNT,
+                      isVendor(next));
+  }
+  TEST_ASSERT_FALSE(isVendor(0));
+  TEST_ASSERT_FALSE(isVendor(0xFFFFFF));
+
+  uint8_t mac[6] = {0x00, 0x00, 0x00, 0x12, 0x34, 0x56}; // no vendor OUI
+  TEST_ASSERT_FALSE(count(mac));
+  TEST_ASSERT_EQUAL_UINT(0, macs_wifi);
+
+#ifdef PROBE_FINGERPRINT
+  // clustered randomized MACs have no vendor OUI and pass the filter
+  mac[0] = 0x02;
+  COUNT_MUTEX_LOCK();
+  const bool added = mac_add(mac, mac_hash(mac, salt), -70, MAC_SNIFF_PROBE);
+  COUNT_MUTEX_UNLOCK();
+  TEST_ASSERT_TRUE(added);
+  TEST_ASSERT_EQUAL_UINT(1, macs_wifi);
+#endif
+}
+#endif
+
+#ifdef BLECOUNTER
+// canned advertisements get class expected from rules of bleclass_array.h
+void test_ble_classify(void) {
+  for (uint8_t i = 0; i < ADVERTS; i++)
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(adverts[i].cls,
+                                   ble_classify(adverts[i].data,
+                                                adverts[i].len),
+                                   adverts[i].name);
+}
+#endif
+
+#ifdef COUNT_VISITS
+// two send cycles of devices with known overlap: returning and departed
+// devices are off by no more than the expected hash collisions,
+// pax^2 / 2^17, twice
+void test_visits(void) {
+  static const uint16_t venues[][2] = {{100, 50}, {1000, 300}, {3000, 2500}};
+  uint8_t mac[6];
+  uint16_t newpax, back, departed;
+  for (uint8_t v = 0; v < 3; v++) {
+    const uint16_t pax = venues[v][0], stay = venues[v][1];
+    sendCounter(); // previous epoch holds no device of this venue
+    // device i is there in first cycle if i < pax, in second if i >= stay
+    for (uint8_t cycle = 0; cycle < 2; cycle++) {
+      for (uint16_t i = cycle ? pax - stay : 0;
+           i < (cycle ? 2 * pax - stay : pax); i++) {
+        make_mac(mac, i, v);
+        count(mac);
+      }
+      visits_get(&newpax, &back, &departed);
+      sendCounter();
+    }
+    const int32_t collisions = (uint32_t)pax * pax / 65536 + 1;
+    TEST_ASSERT_INT_WITHIN(collisions, stay, back);
+    TEST_ASSERT_INT_WITHIN(collisions, pax - stay, departed);
+  }
+}
+#endif
+
+#ifdef SNAPSHOT_SIZE
+// round trip of snapshots for few to many devices, one third of them BLE;
+// a flipped bit fails CRC and keeps bitmaps as they are
+void test_snapshot(void) {
+  static const uint16_t levels[] = {100, 1000, 1500, 5000, 30000};
+  static MacBitmap wifi, ble, wifi2, ble2;
+  static uint8_t buf[SNAPSHOT_MAX];
+  for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+    wifi.clear();
+    ble.clear();
+    for (uint16_t i = 0; i < levels[l]; i++)
+      (i % 3 ? wifi : ble).insert(esp_random());
+    const Snapshot_t state = {7, salt, levels[l], (uint16_t)wifi.size(),
+                              (uint16_t)ble.size()};
+    Snapshot_t restored;
+
+    const size_t n = snapshot_encode(buf, sizeof(buf), &state, &wifi, &ble);
+    TEST_ASSERT_TRUE(n > 0);
+    TEST_ASSERT_TRUE(snapshot_decode(buf, n, &restored, &wifi2, &ble2));
+    TEST_ASSERT_EQUAL_UINT(state.epoch, restored.epoch);
+    TEST_ASSERT_EQUAL_UINT(state.salt, restored.salt);
+    TEST_ASSERT_EQUAL_UINT(state.total, restored.total);
+    TEST_ASSERT_EQUAL_UINT(state.wifi, restored.wifi);
+    TEST_ASSERT_EQUAL_UINT(state.ble, restored.ble);
+    for (uint32_t h = 0; h < MACBITMAP_BITS; h++) {
+      TEST_ASSERT_EQUAL(wifi.contains(h), wifi2.contains(h));
+      TEST_ASSERT_EQUAL(ble.contains(h), ble2.contains(h));
+    }
+    // a snapshot too large for RTC memory is refused
+    TEST_ASSERT_EQUAL(n <= SNAPSHOT_SIZE,
+                      snapshot_encode(buf, SNAPSHOT_SIZE, &state, &wifi,
+                                      &ble) > 0);
+    snapshot_encode(buf, sizeof(buf), &state, &wifi, &ble);
+    buf[n / 2] ^= 0x10;
+    TEST_ASSERT_FALSE(snapshot_decode(buf, n, &restored, &wifi2, &ble2));
+    TEST_ASSERT_EQUAL_UINT(wifi.size(), wifi2.size());
+  }
+}
+
+// a snapshot too large for RTC memory is saved to NVS on restart by command
+// and restored from there after software reset only, once
+void test_snapshot_nvs(void) {
+  uint8_t mac[6];
+  for (uint32_t i = 0; i < 8000; i++) {
+    make_mac(mac, i, 9);
+    count(mac);
+  }
+  COUNT_MUTEX_LOCK();
+  const uint32_t saltsaved = salt;
+  const uint16_t wifi = macs_wifi;
+  snapshot_save(true);
+  // state lost by restart
+  salt = ~salt;
+  macs_wifi = 0;
+  macs.clear();
+  COUNT_MUTEX_UNLOCK();
+
+  native_reset_reason = SW_CPU_RESET;
+  const bool restored = snapshot_restore(), again = snapshot_restore();
+  native_reset_reason = POWERON_RESET;
+  TEST_ASSERT_TRUE(restored);
+  TEST_ASSERT_FALSE(again);
+  TEST_ASSERT_EQUAL_UINT(saltsaved, salt);
+  TEST_ASSERT_EQUAL_UINT(wifi, macs_wifi);
+  make_mac(mac, 0, 9);
+  TEST_ASSERT_FALSE(count(mac)); // device of saved cycle is not counted again
+}
+#endif
+
+// many send cycles of few to many distinct devices: counts stay within 2%
+// and heap does not grow after the first round of cycles
+void test_soak(void) {
+  static const uint32_t levels[] = {1000, 4000, 10000, 30000, 60000};
+  uint8_t mac[6];
+  size_t heap = 0;
+  bool estimated;
+  for (uint8_t round = 0; round < 4; round++) {
+    for (uint8_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+      for (uint32_t i = 0; i < levels[l]; i++) {
+        make_mac(mac, esp_random(), round);
+        count(mac);
+      }
+      COUNT_MUTEX_LOCK();
+      const uint16_t counted = macs.estimate(&estimated);
+      COUNT_MUTEX_UNLOCK();
+      TEST_ASSERT_UINT_WITHIN(levels[l] / 50 + 10, levels[l], counted);
+      sendCounter(); // also resets counters
+    }
+    if (!round)
+      heap = mallinfo2().uordblks;
+  }
+  TEST_ASSERT_TRUE(mallinfo2().uordblks <= heap);
+}
+
+int main(int argc, char **argv) {
+  // same startup sequence as setup() in main.cpp, as far as it applies
+  loadConfig();
+  payload.setFormat(cfg.payloadformat);
+  get_salt();
+#ifdef COUNT_WINDOWS
+  window_init();
+#endif
+#ifdef DWELL_ENTRIES
+  dwell_init();
+#endif
+#ifdef COUNT_BANDS
+  bands_init();
+#endif
+
+  UNITY_BEGIN();
+  RUN_TEST(test_mac_add);
+#ifdef VENDORFILTER
+  RUN_TEST(test_vendorfilter);
+#endif
+#ifdef BLECOUNTER
+  RUN_TEST(test_ble_classify);
+#endif
+#ifdef COUNT_VISITS
+  RUN_TEST(test_visits);
+#endif
+#ifdef SNAPSHOT_SIZE
+  RUN_TEST(test_snapshot);
+  RUN_TEST(test_snapshot_nvs);
+#endif
+  RUN_TEST(test_soak);
+  return UNITY_END();
+}
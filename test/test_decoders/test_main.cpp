@@ -0,0 +1,288 @@
+// Round trip tests of payload encoders and decoders, native build: records
+// of each payload format are decoded by src/TTN/test_decoders.js with node
+// usage: pio test -e native -f test_decoders
+
+#include "globals.h"
+#include "configmanager.h"
+#ifdef COUNT_SERIES
+#include "countseries.h"
+#endif
+
+#include <unity.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static char vectors[] = "/tmp/paxvectorsXXXXXX";
+static FILE *file;
+
+// write payload as test vector of current format, followed by the values
+// its decoder is expected to return, as JSON object
+static void vector(uint8_t port, const char *expect, ...) {
+  va_list args;
+  fprintf(file, "{\"format\":%u,\"port\":%u,\"bytes\":[", payload.getFormat(),
+          port);
+  for (uint8_t i = 0; i < payload.getSize(); i++)
+    fprintf(file, i ? ",%u" : "%u", payload.getBuffer()[i]);
+  fprintf(file, "],\"expect\":");
+  va_start(args, expect);
+  vfprintf(file, expect, args);
+  va_end(args);
+  fprintf(file, "}\n");
+  payload.reset();
+}
+
+// decode test vectors written so far, path of script is relative to this file
+static void decode(void) {
+  std::string project(__FILE__);
+  project.erase(project.rfind("test/test_decoders/"));
+  const std::string command = "node " + project +
+                              "src/TTN/test_decoders.js " + vectors +
+                              " 2>&1";
+  fclose(file);
+  file = NULL;
+  const int status = system(command.c_str());
+  if (WEXITSTATUS(status) == 127)
+    TEST_IGNORE_MESSAGE("node not found, decoders not tested");
+  TEST_ASSERT_EQUAL_INT(0, WEXITSTATUS(status));
+}
+
+// records of all formats, with values covering sign and byte order
+static const uint16_t wifi = 1234, ble = 56, both = 20;
+static const uint8_t windows[] = {1, 5, 15, 60};
+static const uint16_t windowcounts[] = {10, 300, 1000, 4000};
+static const uint16_t bins[] = {1, 2, 300, 4, 5, 6, 7, 800};
+static const uint16_t bands[] = {5, 10, 1500};
+static const uint16_t yield[] = {100, 2000};
+static const uint8_t share[] = {30, 70};
+static const uint8_t regs[] = {1, 2, 3, 4};
+static const perfStatus_t perf = {1, 2, 3, 4, 5, 600, 7, 8000};
+
+static void add_counts(void) {
+  payload.addCount(wifi, MAC_SNIFF_WIFI);
+  payload.addCount(ble, MAC_SNIFF_BLE);
+  payload.addCount(both, MAC_SNIFF_BOTH);
+  payload.addCountFlags(COUNT_ESTIMATED_WIFI);
+}
+
+#ifdef COUNT_SERIES
+// series of small changes is delta coded, of large changes raw
+static const CountSample_t samples[][3] = {
+    {{100, 10, 5, 0}, {103, 12, 5, COUNT_ESTIMATED_WIFI}, {90, 9, 4, 0}},
+    {{5000, 10, 0, 0}, {100, 9000, 0, 0}, {60000, 3, 0, 0}}};
+
+static void add_series(void) {
+  static const uint8_t content[] = {COUNTSERIES_BLE | COUNTSERIES_BOTH,
+                                    COUNTSERIES_BLE};
+  for (uint8_t s = 0; s < 2; s++) {
+    CountSeries series(3);
+    uint8_t buf[COUNTSERIES_HEADER + 3 * COUNTSERIES_SAMPLE_MAX], taken;
+    for (uint8_t i = 0; i < 3; i++)
+      series.add(&samples[s][i]);
+    payload.addCountSeries(
+        buf, series.encode(buf, sizeof(buf), content[s], &taken));
+    if (s)
+      vector(SERIESPORT, "{\"seq\":0,\"wifi\":[5000,100,60000],"
+                         "\"ble\":[10,9000,3]}");
+    else
+      vector(SERIESPORT,
+             "{\"seq\":0,\"wifi\":[100,103,90],\"ble\":[10,12,9],"
+             "\"both\":[5,5,4],\"estimated\":[0,%u,0]}",
+             COUNT_ESTIMATED_WIFI);
+  }
+}
+#endif
+
+void setUp(void) {
+  file = fdopen(mkstemp(vectors), "w");
+  payload.reset();
+}
+
+void tearDown(void) {
+  if (file)
+    fclose(file);
+  unlink(vectors);
+  strcpy(vectors + strlen(vectors) - 6, "XXXXXX");
+  payload.setFormat(cfg.payloadformat);
+}
+
+void test_plain(void) {
+  payload.setFormat(PAYLOAD_PLAIN);
+  payload.addCount(wifi, MAC_SNIFF_WIFI);
+  payload.addCount(ble, MAC_SNIFF_BLE);
+  vector(COUNTERPORT, "{\"wifi\":%u,\"ble\":%u}", wifi, ble);
+  add_counts();
+  vector(COUNTERPORT,
+         "{\"wifi\":%u,\"ble\":%u,\"both\":%u,\"pax\":%u,\"estimated\":%u}",
+         wifi, ble, both, wifi + ble - both, COUNT_ESTIMATED_WIFI);
+  payload.addStatus(3700, 123456, 42, 150000, 1, 12);
+  vector(STATUSPORT,
+         "{\"battery\":3700,\"uptime\":123456,\"temp\":42,\"memory\":150000,"
+         "\"reset0\":1,\"reset1\":12}");
+  configData_t config = cfg;
+  config.rssilimit = -80;
+  payload.addConfig(config);
+  vector(CONFIGPORT,
+         "{\"lorasf\":%u,\"txpower\":%u,\"rssilimit\":-80,\"sendcycle\":%u,"
+         "\"payloadmask\":%u,\"version\":\"%.10s\"}",
+         config.lorasf, config.txpower, config.sendcycle, config.payloadmask,
+         config.version);
+  payload.addAlarm(-60, 3);
+  vector(BEACONPORT, "{\"rssi\":-60,\"beacon\":3}");
+  payload.addVoltage(3700);
+  vector(BATTPORT, "{\"voltage\":3700}");
+  payload.addSketch(6, 2, regs, sizeof(regs));
+  vector(SKETCHPORT, "{\"precision\":6,\"offset\":2,\"registers\":[1,2,3,4]}");
+  payload.addWindows(windows, windowcounts, 4);
+  vector(WINDOWPORT,
+         "{\"pax1min\":10,\"pax5min\":300,\"pax15min\":1000,\"pax60min\":4000}");
+  payload.addDwell(bins, 8);
+  vector(DWELLPORT, "{\"dwell\":[1,2,300,4,5,6,7,800]}");
+  payload.addChannels(yield, share, 2);
+  vector(CHANNELPORT, "{\"channels\":[{\"yield\":100,\"share\":30},"
+                      "{\"yield\":2000,\"share\":70}]}");
+  payload.addBands(bands, 3);
+  vector(BANDPORT, "{\"near\":5,\"mid\":10,\"far\":1500}");
+  payload.addVisits(7, 800, 9);
+  vector(VISITPORT, "{\"new\":7,\"returning\":800,\"departed\":9}");
+  payload.addPerf(perf);
+  vector(PERFPORT,
+         "{\"wififrames\":1,\"bleadverts\":2,\"rssidropped\":3,"
+         "\"vendordropped\":4,\"ringdropped\":5,\"collisions\":600,"
+         "\"insertns\":7,\"batchmaxus\":8000}");
+#ifdef COUNT_SERIES
+  add_series();
+#endif
+  decode();
+}
+
+void test_packed(void) {
+  payload.setFormat(PAYLOAD_PACKED);
+  payload.addCount(wifi, MAC_SNIFF_WIFI);
+  payload.addCount(ble, MAC_SNIFF_BLE);
+  vector(COUNTERPORT, "{\"wifi\":%u,\"ble\":%u}", wifi, ble);
+  add_counts();
+  vector(COUNTERPORT,
+         "{\"wifi\":%u,\"ble\":%u,\"both\":%u,\"pax\":%u,\"estimated\":%u}",
+         wifi, ble, both, wifi + ble - both, COUNT_ESTIMATED_WIFI);
+  payload.addStatus(3700, 123456, 42, 150000, 1, 12);
+  vector(STATUSPORT,
+         "{\"voltage\":3700,\"uptime\":123456,\"cputemp\":42,"
+         "\"memory\":150000,\"reset0\":1,\"reset1\":12}");
+  configData_t config = cfg;
+  config.rssilimit = -80;
+  config.adrmode = 1;
+  config.blescan = 0;
+  config.payloadmask = COUNT_DATA | BATT_DATA;
+  payload.addConfig(config);
+  vector(CONFIGPORT,
+         "{\"lorasf\":%u,\"txpower\":%u,\"rssilimit\":-80,\"sendcycle\":%u,"
+         "\"flags\":{\"adr\":1,\"blescan\":0},"
+         "\"payloadmask\":{\"gps\":0,\"counter\":1,\"battery\":1},"
+         "\"version\":\"%.10s\"}",
+         config.lorasf, config.txpower, config.sendcycle, config.version);
+  payload.addAlarm(-60, 3);
+  vector(BEACONPORT, "{\"rssi\":-60,\"beacon\":3}");
+  payload.addVoltage(3700);
+  vector(BATTPORT, "{\"voltage\":3700}");
+  payload.addSketch(6, 2, regs, sizeof(regs));
+  vector(SKETCHPORT, "{\"precision\":6,\"offset\":2,\"registers\":[1,2,3,4]}");
+  payload.addWindows(windows, windowcounts, 4);
+  vector(WINDOWPORT,
+         "{\"pax1min\":10,\"pax5min\":300,\"pax15min\":1000,\"pax60min\":4000}");
+  payload.addDwell(bins, 8);
+  vector(DWELLPORT, "{\"dwell\":[1,2,300,4,5,6,7,800]}");
+  payload.addChannels(yield, share, 2);
+  vector(CHANNELPORT, "{\"channels\":[{\"yield\":100,\"share\":30},"
+                      "{\"yield\":2000,\"share\":70}]}");
+  payload.addBands(bands, 3);
+  vector(BANDPORT, "{\"near\":5,\"mid\":10,\"far\":1500}");
+  payload.addVisits(7, 800, 9);
+  vector(VISITPORT, "{\"new\":7,\"returning\":800,\"departed\":9}");
+  payload.addPerf(perf);
+  vector(PERFPORT,
+         "{\"wififrames\":1,\"bleadverts\":2,\"rssidropped\":3,"
+         "\"vendordropped\":4,\"ringdropped\":5,\"collisions\":600,"
+         "\"insertns\":7,\"batchmaxus\":8000}");
+#ifdef COUNT_SERIES
+  add_series();
+#endif
+  decode();
+}
+
+// Cayenne LPP with channels, names of decoded fields are type_channel
+void test_lpp_dynamic(void) {
+  payload.setFormat(PAYLOAD_LPP_DYNAMIC);
+  add_counts();
+  vector(LPP1PORT,
+         "{\"luminosity_%u\":%u,\"luminosity_%u\":%u,\"luminosity_%u\":%u,"
+         "\"digital_in_%u\":%u}",
+         LPP_COUNT_WIFI_CHANNEL, wifi, LPP_COUNT_BLE_CHANNEL, ble,
+         LPP_COUNT_BOTH_CHANNEL, both, LPP_COUNT_FLAGS_CHANNEL,
+         COUNT_ESTIMATED_WIFI);
+  payload.addStatus(3700, 123456, -5.5, 150000, 1, 12);
+  vector(LPP1PORT, "{\"temperature_%u\":-5.5}", LPP_TEMPERATURE_CHANNEL);
+  configData_t config = cfg;
+  config.adrmode = 1;
+  payload.addConfig(config);
+  vector(LPP1PORT, "{\"digital_in_%u\":1}", LPP_ADR_CHANNEL);
+  payload.addAlarm(-60, 3);
+  vector(LPP1PORT, "{\"presence_%u\":3,\"analog_in_%u\":-60}",
+         LPP_ALARM_CHANNEL, LPP_MSG_CHANNEL);
+  payload.addVoltage(3700);
+  vector(LPP1PORT, "{\"analog_in_%u\":3.7}", LPP_BATT_CHANNEL);
+  payload.addWindows(windows, windowcounts, 4);
+  vector(LPP1PORT,
+         "{\"luminosity_%u\":10,\"luminosity_%u\":300,\"luminosity_%u\":1000,"
+         "\"luminosity_%u\":4000}",
+         LPP_WINDOW_CHANNEL, LPP_WINDOW_CHANNEL + 1, LPP_WINDOW_CHANNEL + 2,
+         LPP_WINDOW_CHANNEL + 3);
+  payload.addDwell(bins, 2);
+  vector(LPP1PORT, "{\"luminosity_%u\":1,\"luminosity_%u\":2}",
+         LPP_DWELL_CHANNEL, LPP_DWELL_CHANNEL + 1);
+  payload.addBands(bands, 3);
+  vector(LPP1PORT,
+         "{\"luminosity_%u\":5,\"luminosity_%u\":10,\"luminosity_%u\":1500}",
+         LPP_BAND_CHANNEL, LPP_BAND_CHANNEL + 1, LPP_BAND_CHANNEL + 2);
+  payload.addVisits(7, 800, 9);
+  vector(LPP1PORT,
+         "{\"luminosity_%u\":7,\"luminosity_%u\":800,\"luminosity_%u\":9}",
+         LPP_VISIT_CHANNEL, LPP_VISIT_CHANNEL + 1, LPP_VISIT_CHANNEL + 2);
+  decode();
+}
+
+// Cayenne LPP without channels, values of a type are numbered from 0
+void test_lpp_packed(void) {
+  payload.setFormat(PAYLOAD_LPP_PACKED);
+  add_counts();
+  vector(LPP2PORT, "{\"luminosity_0\":%u,\"luminosity_1\":%u,"
+                   "\"luminosity_2\":%u,\"digital_in_0\":%u}",
+         wifi, ble, both, COUNT_ESTIMATED_WIFI);
+  payload.addStatus(3700, 123456, -5.5, 150000, 1, 12);
+  vector(LPP2PORT, "{\"temperature_0\":-5.5}");
+  payload.addAlarm(-60, 3);
+  vector(LPP2PORT, "{\"presence_0\":3,\"analog_in_0\":-60}");
+  payload.addVoltage(3700);
+  vector(LPP2PORT, "{\"analog_in_0\":3.7}");
+  payload.addBands(bands, 3);
+  vector(LPP2PORT,
+         "{\"luminosity_0\":5,\"luminosity_1\":10,\"luminosity_2\":1500}");
+  payload.addVisits(7, 800, 9);
+  vector(LPP2PORT,
+         "{\"luminosity_0\":7,\"luminosity_1\":800,\"luminosity_2\":9}");
+  decode();
+}
+
+int main(int argc, char **argv) {
+  loadConfig();
+  payload.setFormat(cfg.payloadformat);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_plain);
+  RUN_TEST(test_packed);
+  RUN_TEST(test_lpp_dynamic);
+  RUN_TEST(test_lpp_packed);
+  return UNITY_END();
+}
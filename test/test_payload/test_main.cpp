@@ -0,0 +1,448 @@
+// Unit tests of payload encoders, send path and send queues, native build
+// usage: pio test -e native -f test_payload
+
+#include "globals.h"
+#include "configmanager.h"
+#include "rcommand.h"
+#include "senddata.h"
+#include "sendscheduler.h"
+#include "native/fixtures.h"
+
+#include <unity.h>
+#include <thread>
+#include <vector>
+
+static std::vector<MessageBuffer_t> sent;
+
+static void keep_sent(const MessageBuffer_t *message) {
+  sent.push_back(*message);
+}
+
+void setUp(void) {
+  sent.clear();
+  payload.setFormat(PAYLOAD_ENCODER);
+  payload.reset();
+}
+
+void tearDown(void) {
+  native_sent = NULL;
+  native_busy = false;
+  native_maxpayload = PAYLOAD_BUFFER_SIZE;
+}
+
+// count record as laid out by each format
+void test_count_records(void) {
+  static const uint8_t plain[] = {0x12, 0x34}, packed[] = {0x34, 0x12},
+                       lppdyn[] = {LPP_COUNT_BLE_CHANNEL, LPP_LUMINOSITY, 0x12,
+                                   0x34},
+                       lpppkd[] = {LPP_LUMINOSITY, 0x12, 0x34};
+  static const uint8_t *expected[] = {plain, packed, lppdyn, lpppkd};
+  static const uint8_t sizes[] = {sizeof(plain), sizeof(packed),
+                                  sizeof(lppdyn), sizeof(lpppkd)};
+
+  for (uint8_t f = PAYLOAD_PLAIN; f <= PAYLOAD_LPP_PACKED; f++) {
+    TEST_ASSERT_TRUE(payload.setFormat(f));
+    TEST_ASSERT_TRUE(payload.addCount(0x1234, MAC_SNIFF_BLE));
+    TEST_ASSERT_EQUAL_UINT(sizes[f - 1], payload.getSize());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected[f - 1], payload.getBuffer(),
+                                 sizes[f - 1]);
+    TEST_ASSERT_EQUAL(f <= PAYLOAD_PACKED, payload.hasPorts());
+  }
+  TEST_ASSERT_FALSE(payload.setFormat(0));
+  TEST_ASSERT_FALSE(payload.setFormat(PAYLOAD_LPP_PACKED + 1));
+  TEST_ASSERT_EQUAL_UINT(PAYLOAD_LPP_PACKED, payload.getFormat());
+}
+
+// other multi byte records keep byte order of their format
+void test_byte_order(void) {
+  payload.setFormat(PAYLOAD_PLAIN);
+  payload.addVoltage(3712);
+  payload.addAlarm(-60, 7);
+  static const uint8_t plain[] = {0x0E, 0x80, 0xC4, 0x07};
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(plain, payload.getBuffer(), sizeof(plain));
+
+  payload.setFormat(PAYLOAD_PACKED);
+  payload.addVoltage(3712);
+  static const uint8_t packed[] = {0x80, 0x0E};
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(packed, payload.getBuffer(), sizeof(packed));
+
+  payload.setFormat(PAYLOAD_LPP_DYNAMIC);
+  payload.addVoltage(3712); // 0.01 V
+  static const uint8_t lppdyn[] = {LPP_BATT_CHANNEL, LPP_ANALOG_INPUT, 0x01,
+                                   0x73};
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(lppdyn, payload.getBuffer(), sizeof(lppdyn));
+}
+
+// each payload format selected by remote command, buffer filled up with
+// count records; a record which does not fit is refused and leaves the
+// buffer as is
+void test_formats_fill(void) {
+  static const uint8_t countsize[] = {2, 2, 4, 3}; // plain .. LPP packed
+  for (uint8_t f = PAYLOAD_PLAIN; f <= PAYLOAD_LPP_PACKED; f++) {
+    uint8_t cmd[] = {0x17, f};
+    rcommand(cmd, sizeof(cmd));
+    TEST_ASSERT_EQUAL_UINT(f, payload.getFormat());
+    TEST_ASSERT_EQUAL_UINT(f, cfg.payloadformat);
+    payload.reset();
+    uint8_t records = 0;
+    while (payload.addCount(records, MAC_SNIFF_WIFI))
+      records++;
+    const uint8_t used = payload.getSize();
+    TEST_ASSERT_EQUAL_UINT(PAYLOAD_BUFFER_SIZE / countsize[f - 1], records);
+    TEST_ASSERT_FALSE(payload.addStatus(3900, 1, 45, 1, 1, 1));
+    TEST_ASSERT_EQUAL_UINT(used, payload.getSize());
+  }
+  uint8_t cmd[] = {0x17, PAYLOAD_LPP_PACKED + 1}; // invalid, ignored
+  rcommand(cmd, sizeof(cmd));
+  TEST_ASSERT_EQUAL_UINT(PAYLOAD_LPP_PACKED, cfg.payloadformat);
+  cmd[1] = PAYLOAD_ENCODER;
+  rcommand(cmd, sizeof(cmd));
+}
+
+// one record of each type, records not compiled in return false
+static const uint8_t regs[] = {1, 2, 3, 4}, windows[] = {1, 5, 15, 60};
+static const uint16_t counts[] = {1, 2, 3, 4, 5, 6, 7, 8};
+static bool (*const records[])(PayloadConvert &) = {
+    [](PayloadConvert &p) { return p.addCount(1234, MAC_SNIFF_WIFI); },
+    [](PayloadConvert &p) { return p.addCountFlags(COUNT_ESTIMATED_WIFI); },
+    [](PayloadConvert &p) { return p.addAlarm(-60, 3); },
+    [](PayloadConvert &p) { return p.addVoltage(3700); },
+    [](PayloadConvert &p) { return p.addConfig(cfg); },
+    [](PayloadConvert &p) { return p.addStatus(3700, 1, -5.5, 1, 1, 1); },
+    [](PayloadConvert &p) { return p.addGPS(gpsStatus_t()); },
+    [](PayloadConvert &p) { return p.addBME(bmeStatus_t()); },
+    [](PayloadConvert &p) { return p.addButton(1); },
+    [](PayloadConvert &p) { return p.addSketch(6, 2, regs, 4); },
+    [](PayloadConvert &p) { return p.addWindows(windows, counts, 4); },
+    [](PayloadConvert &p) { return p.addDwell(counts, 8); },
+    [](PayloadConvert &p) { return p.addChannels(counts, regs, 2); },
+    [](PayloadConvert &p) { return p.addBands(counts, 3); },
+    [](PayloadConvert &p) { return p.addVisits(7, 800, 9); },
+    [](PayloadConvert &p) { return p.addPerf(perfStatus_t()); }};
+
+// each record of each format fits into a buffer with exactly as many bytes
+// left as it writes, and is refused with one byte less, so record sizes
+// checked by add*() match what the format writes
+void test_record_sizes(void) {
+  static const uint8_t countsize[] = {2, 2, 4, 3}; // plain .. LPP packed
+  for (uint8_t f = PAYLOAD_PLAIN; f <= PAYLOAD_LPP_PACKED; f++) {
+    for (uint8_t r = 0; r < sizeof(records) / sizeof(records[0]); r++) {
+      PayloadConvert empty(PAYLOAD_BUFFER_SIZE);
+      empty.setFormat(f);
+      if (!records[r](empty))
+        continue;
+      const uint8_t n = empty.getSize();
+      // buffer of three count records plus n bytes
+      const uint8_t filler = countsize[f - 1];
+      for (uint8_t less = 0; less <= (n ? 1 : 0); less++) {
+        PayloadConvert full(3 * filler + n - less);
+        full.setFormat(f);
+        for (uint8_t i = 0; i < 3; i++)
+          TEST_ASSERT_TRUE(full.addCount(i, MAC_SNIFF_WIFI));
+        char message[40];
+        snprintf(message, sizeof(message), "format %u record %u, %u bytes", f,
+                 r, n - less);
+        TEST_ASSERT_EQUAL_MESSAGE(!less, records[r](full), message);
+        TEST_ASSERT_EQUAL_UINT_MESSAGE(3 * filler + (less ? 0 : n),
+                                       full.getSize(), message);
+      }
+    }
+  }
+}
+
+// pending alarms of ten beacons at maximum payload of US SF10: frames do
+// not exceed maximum payload and carry all alarms
+void test_beacon_alarms(void) {
+  uint8_t mac[6] = {0x02, 0, 0, 0, 0, 0}, alarms = 0;
+  native_sent = keep_sent;
+  native_maxpayload = 11;
+  payload.setFormat(PAYLOAD_PLAIN);
+  cfg.monitormode = 1;
+  for (uint8_t i = 0; i < 10; i++) {
+    mac[5] = i;
+    TEST_ASSERT_TRUE(beacon_set(i, macConvert(mac)));
+    COUNT_MUTEX_LOCK();
+    mac_add(mac, mac_hash(mac, salt), -70, MAC_SNIFF_WIFI);
+    COUNT_MUTEX_UNLOCK();
+  }
+  cfg.monitormode = 0;
+  sendBeaconAlarms();
+  TEST_ASSERT_TRUE(sent.size() > 1);
+  for (const MessageBuffer_t &m : sent) {
+    TEST_ASSERT_EQUAL_UINT(BEACONPORT, m.MessagePort);
+    TEST_ASSERT_TRUE(m.MessageSize <= 11);
+    alarms += m.MessageSize / 2;
+  }
+  TEST_ASSERT_EQUAL_UINT(10, alarms);
+}
+
+#ifdef SEND_AGGREGATE
+// records of one send cycle at maximum payloads of EU SF9 (capped by payload
+// buffer) and US SF10: aggregate frames do not exceed maximum payload and
+// split into records exactly; a frame of one record goes on its own port
+void test_aggregate(void) {
+  static const uint8_t maxpayload[] = {PAYLOAD_BUFFER_SIZE, 11},
+                       frames[] = {1, 2};
+  native_sent = keep_sent;
+  for (uint8_t d = 0; d < sizeof(maxpayload); d++) {
+    uint8_t records = 0;
+    native_maxpayload = maxpayload[d];
+    sent.clear();
+    beginAggregate();
+    payload.reset();
+    payload.addCount(100, MAC_SNIFF_WIFI);
+    payload.addCount(30, MAC_SNIFF_BLE);
+    SendPayload(COUNTERPORT);
+    payload.reset();
+    payload.addVoltage(3700);
+    SendPayload(BATTPORT);
+    payload.reset();
+    payload.addButton(1);
+    SendPayload(BUTTONPORT);
+    payload.reset();
+    payload.addAlarm(-60, 3);
+    SendPayload(BEACONPORT);
+    sendAggregate();
+
+    TEST_ASSERT_EQUAL_UINT(frames[d], sent.size());
+    for (const MessageBuffer_t &m : sent) {
+      TEST_ASSERT_TRUE(m.MessageSize <= maxpayload[d]);
+      if (m.MessagePort != AGGREGATEPORT) {
+        records++;
+        continue;
+      }
+      uint8_t i = 0;
+      while (i + 2 <= m.MessageSize) {
+        i += 2 + m.Message[i + 1];
+        records++;
+      }
+      TEST_ASSERT_EQUAL_UINT(m.MessageSize, i);
+    }
+    TEST_ASSERT_EQUAL_UINT(4, records);
+  }
+}
+
+// a record of another task, like a remote command reply from LMIC task, is
+// sent at once on its own port, not within the aggregate of the send cycle
+void test_aggregate_task(void) {
+  native_sent = keep_sent;
+  beginAggregate();
+  payload.reset();
+  payload.addCount(100, MAC_SNIFF_WIFI);
+  SendPayload(COUNTERPORT);
+  std::thread reply([] {
+    payload.reset();
+    payload.addVoltage(3700);
+    SendPayload(BATTPORT);
+  });
+  reply.join();
+  TEST_ASSERT_EQUAL_UINT(1, sent.size());
+  TEST_ASSERT_EQUAL_UINT(BATTPORT, sent[0].MessagePort);
+  payload.reset();
+  payload.addAlarm(-60, 3);
+  SendPayload(BEACONPORT);
+  sendAggregate();
+
+  TEST_ASSERT_EQUAL_UINT(2, sent.size());
+  TEST_ASSERT_EQUAL_UINT(AGGREGATEPORT, sent[1].MessagePort);
+  TEST_ASSERT_EQUAL_UINT(COUNTERPORT, sent[1].Message[0]);
+  TEST_ASSERT_EQUAL_UINT(BEACONPORT, sent[1].Message[2 + sent[1].Message[1]]);
+}
+#endif
+
+#ifdef COUNT_SERIES
+// traces kept while LoRa is busy, encoded in runs of maximum payload,
+// decode to the same counts and flags with consecutive sequence numbers;
+// no run takes more bytes than its counts raw, as on random trace
+void test_series_roundtrip(void) {
+  static CountSeries series(COUNT_SERIES);
+  static CountSample_t trace[COUNT_SERIES], decoded[COUNTSERIES_RUN];
+  uint8_t buf[PAYLOAD_BUFFER_SIZE];
+
+  for (uint8_t t = 0; t < 4; t++) {
+    uint16_t samples = 0;
+    uint8_t first = 0, content = COUNTSERIES_BLE;
+    make_trace(trace, t % 3);
+    if (t == 3) { // with cross deduplication, some counts estimated
+      content |= COUNTSERIES_BOTH;
+      for (uint16_t i = 0; i < COUNT_SERIES; i++) {
+        trace[i].both = trace[i].ble / 2;
+        trace[i].flags = i % 7 ? 0 : COUNT_ESTIMATED_WIFI;
+      }
+    }
+    series.clear();
+    for (uint16_t i = 0; i < COUNT_SERIES; i++)
+      series.add(&trace[i]);
+    while (series.getCount()) {
+      uint8_t taken, seq;
+      const uint8_t n = series.encode(buf, sizeof(buf), content, &taken);
+      TEST_ASSERT_TRUE(n > 0);
+      const uint8_t raw =
+          (t == 3 ? 6 : 4) + (buf[1] & COUNTSERIES_FLAGS ? 1 : 0);
+      TEST_ASSERT_TRUE(n <= COUNTSERIES_HEADER + taken * raw);
+      const uint8_t m =
+          CountSeries::decode(buf, n, &seq, decoded, COUNTSERIES_RUN);
+      TEST_ASSERT_EQUAL_UINT(taken, m);
+      if (!samples)
+        first = seq;
+      TEST_ASSERT_EQUAL_UINT8(first + samples, seq);
+      for (uint8_t i = 0; i < m; i++) {
+        TEST_ASSERT_EQUAL_UINT(trace[samples + i].wifi, decoded[i].wifi);
+        TEST_ASSERT_EQUAL_UINT(trace[samples + i].ble, decoded[i].ble);
+        TEST_ASSERT_EQUAL_UINT(trace[samples + i].both, decoded[i].both);
+        TEST_ASSERT_EQUAL_UINT(trace[samples + i].flags, decoded[i].flags);
+      }
+      series.drop(taken);
+      samples += taken;
+    }
+    TEST_ASSERT_EQUAL_UINT(COUNT_SERIES, samples);
+  }
+}
+
+static uint16_t cycles;
+
+// counts cycles of series runs sent alone or in an aggregate frame
+static void count_series(const MessageBuffer_t *message) {
+  CountSample_t s[COUNTSERIES_RUN];
+  uint8_t seq;
+  if (message->MessagePort == SERIESPORT)
+    cycles += CountSeries::decode(message->Message, message->MessageSize,
+                                  &seq, s, COUNTSERIES_RUN);
+  for (uint8_t i = 0; message->MessagePort == AGGREGATEPORT &&
+                      i + 2 <= message->MessageSize;
+       i += 2 + message->Message[i + 1])
+    if (message->Message[i] == SERIESPORT)
+      cycles += CountSeries::decode(message->Message + i + 2,
+                                    message->Message[i + 1], &seq, s,
+                                    COUNTSERIES_RUN);
+}
+
+// send cycles while not joined yet, then one cycle with LoRa free: all
+// cycles arrive as runs on SERIESPORT
+void test_series_send(void) {
+  const uint16_t busy = 30;
+  cycles = 0;
+  native_sent = count_series;
+  native_busy = true;
+  for (uint16_t i = 0; i < busy; i++)
+    sendCounter();
+  TEST_ASSERT_EQUAL_UINT(busy, countseries.getCount());
+  native_busy = false;
+  sendCounter();
+  TEST_ASSERT_EQUAL_UINT(busy + 1, cycles);
+  TEST_ASSERT_EQUAL_UINT(0, countseries.getCount());
+}
+#endif
+
+static SendScheduler *transport;
+static uint16_t pushed;
+
+// fake LoRa transport, takes a reference as lora_enqueuedata()
+static void push_transport(const MessageBuffer_t *message) {
+  MessageBuffer_t *m = (MessageBuffer_t *)message;
+  pushed++;
+  sendpool.retain(m);
+  transport->push(m);
+}
+
+// transport blocked while not joined for some send cycles, gets counts, a
+// status reply and a battery reading per cycle and a beacon alarm every
+// fourth one. Then drained, alarms and replies come first, one reply and
+// reading only, and all messages are accounted for per class
+void test_scheduler(void) {
+  SendScheduler queue(SEND_QUEUE_SIZE,
+                      [](MessageBuffer_t *m) { sendpool.release(m); });
+  uint16_t sent[SEND_CLASSES] = {0}, alarms = 0;
+  uint8_t last = 0;
+
+  transport = &queue;
+  pushed = 0;
+  native_sent = push_transport;
+  for (uint8_t cycle = 0; cycle < 12; cycle++) {
+    uint8_t cmd[] = {0x81};
+    sendCounter();
+    rcommand(cmd, sizeof(cmd));
+    payload.reset();
+    payload.addVoltage(3700 + cycle);
+    SendPayload(BATTPORT);
+    if (!(cycle % 4)) {
+      payload.reset();
+      payload.addAlarm(-60, cycle);
+      SendPayload(BEACONPORT);
+      alarms++;
+    }
+  }
+  native_sent = NULL;
+  TEST_ASSERT_TRUE(pushed > SEND_QUEUE_SIZE);
+
+  while (MessageBuffer_t *m = queue.pop()) {
+    TEST_ASSERT_TRUE(m->MessagePrio >= last); // most urgent class first
+    last = m->MessagePrio;
+    sent[m->MessagePrio]++;
+    sendpool.release(m); // as lora_send()
+  }
+  TEST_ASSERT_EQUAL_UINT(alarms, sent[SEND_ALARM]);
+  TEST_ASSERT_EQUAL_UINT(1, sent[SEND_RESPONSE]);
+  TEST_ASSERT_EQUAL_UINT(0, sendpool.getUsed());
+  for (uint8_t c = 0; c < SEND_CLASSES; c++) {
+    const SendStats_t *stats = queue.getStats(c);
+    TEST_ASSERT_EQUAL_UINT(sent[c],
+                           stats->queued - stats->coalesced - stats->dropped);
+  }
+}
+
+// buffers of all messages sent so far are back in the pool; a full pool
+// refuses and counts requests, and a buffer only returns after its last
+// reference is released
+void test_sendpool(void) {
+  static MessageBuffer_t *held[SEND_POOL_SIZE];
+  TEST_ASSERT_EQUAL_UINT(0, sendpool.getUsed());
+  const uint32_t exhausted = sendpool.getExhausted();
+  for (uint8_t i = 0; i < SEND_POOL_SIZE; i++)
+    TEST_ASSERT_NOT_NULL(held[i] = sendpool.alloc());
+  TEST_ASSERT_NULL(sendpool.alloc());
+  TEST_ASSERT_EQUAL_UINT(exhausted + 1, sendpool.getExhausted());
+  TEST_ASSERT_EQUAL_UINT(SEND_POOL_SIZE, sendpool.getHighwater());
+  sendpool.retain(held[0]); // second queue
+  sendpool.release(held[0]);
+  TEST_ASSERT_NULL(sendpool.alloc()); // still referenced
+  sendpool.release(held[0]);
+  TEST_ASSERT_TRUE(sendpool.alloc() == held[0]);
+  for (uint8_t i = 0; i < SEND_POOL_SIZE; i++)
+    sendpool.release(held[i]);
+  TEST_ASSERT_EQUAL_UINT(0, sendpool.getUsed());
+}
+
+int main(int argc, char **argv) {
+  // same startup sequence as setup() in main.cpp, as far as it applies
+  loadConfig();
+  payload.setFormat(cfg.payloadformat);
+  get_salt();
+#ifdef COUNT_WINDOWS
+  window_init();
+#endif
+#ifdef DWELL_ENTRIES
+  dwell_init();
+#endif
+#ifdef COUNT_BANDS
+  bands_init();
+#endif
+
+  UNITY_BEGIN();
+  RUN_TEST(test_count_records);
+  RUN_TEST(test_byte_order);
+  RUN_TEST(test_formats_fill);
+  RUN_TEST(test_record_sizes);
+  RUN_TEST(test_beacon_alarms);
+#ifdef SEND_AGGREGATE
+  RUN_TEST(test_aggregate);
+  RUN_TEST(test_aggregate_task);
+#endif
+#ifdef COUNT_SERIES
+  RUN_TEST(test_series_roundtrip);
+  RUN_TEST(test_series_send);
+#endif
+  RUN_TEST(test_scheduler);
+  RUN_TEST(test_sendpool); // last, checks for buffers leaked by all tests
+  return UNITY_END();
+}
@@ -0,0 +1,63 @@
+# vendors.py
+# generates sorted OUI table include/vendor_array.h from src/vendors.txt
+#
+# usage: python vendors.py [source] [header]
+# also called by pre-build script build.py on each build
+
+import re
+import sys
+import os.path
+
+# "38F23E", "38-F2-3E   (hex)  Apple, Inc." or "38:f2:3e ..."
+OUI = re.compile(r"^\s*([0-9A-Fa-f]{2})[-:]?([0-9A-Fa-f]{2})[-:]?([0-9A-Fa-f]{2})(\s|$)")
+
+HEADER = """#ifndef _VENDOR_ARRAY_H
+#define _VENDOR_ARRAY_H
+
+// generated by vendors.py from src/vendors.txt, do not edit
+// sorted ascending for binary search in isVendor()
+
+#define VENDORS_COUNT %d
+
+static const uint32_t vendors[VENDORS_COUNT] = {
+%s};
+
+#endif
+"""
+
+
+def read_ouis(source):
+    ouis = set()
+    with open(source) as f:
+        for line in f:
+            if line.lstrip().startswith("#"):
+                continue
+            m = OUI.match(line)
+            if m:
+                ouis.add(int(m.group(1) + m.group(2) + m.group(3), 16))
+    return sorted(ouis)
+
+
+def generate(source, header):
+    ouis = read_ouis(source)
+    if not ouis:
+        sys.exit("No OUIs found in " + source + "! Aborting.")
+    rows = []
+    for i in range(0, len(ouis), 7):
+        rows.append("    " + ", ".join("0x%06x" % o for o in ouis[i:i + 7]) + ",\n")
+    content = HEADER % (len(ouis), "".join(rows))
+    # rewrite only if changed, to not trigger needless rebuilds
+    if os.path.isfile(header):
+        with open(header) as f:
+            if f.read() == content:
+                return len(ouis)
+    with open(header, "w") as f:
+        f.write(content)
+    return len(ouis)
+
+
+if __name__ == "__main__":
+    base = os.path.dirname(os.path.abspath(__file__))
+    source = sys.argv[1] if len(sys.argv) > 1 else os.path.join(base, "src", "vendors.txt")
+    header = sys.argv[2] if len(sys.argv) > 2 else os.path.join(base, "include", "vendor_array.h")
+    print("Generated %s with %d OUIs" % (header, generate(source, header)))